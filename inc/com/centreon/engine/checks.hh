@@ -183,6 +183,8 @@ int check_host_check_viability_3x(
       time_t* new_time);
 int adjust_host_check_attempt_3x(host* hst, int is_active);
 int determine_host_reachability(host* hst);
+void rebuild_host_reachability();
+void update_host_reachability(host* hst);
 
 #  ifdef __cplusplus
 }
@@ -36,7 +36,9 @@
 #  define EXTERNAL_COMMAND_STATS               8
 #  define PARALLEL_HOST_CHECK_STATS            9
 #  define SERIAL_HOST_CHECK_STATS              10
-#  define MAX_CHECK_STATS_TYPES                11
+#  define COALESCED_HOST_CHECK_STATS           11
+#  define COALESCED_SERVICE_CHECK_STATS        12
+#  define MAX_CHECK_STATS_TYPES                13
 #  define CHECK_STATS_BUCKETS                  15
 
 /**
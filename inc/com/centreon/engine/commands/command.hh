@@ -24,6 +24,7 @@
 #  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/commands/command_listener.hh"
 #  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/macros/command_template.hh"
 #  include "com/centreon/engine/macros/defines.hh"
 #  include "com/centreon/engine/namespace.hh"
 
@@ -75,6 +76,7 @@ namespace                      commands {
     std::string                _command_line;
     command_listener*          _listener;
     std::string                _name;
+    macros::command_template   _template;
   };
 }
 
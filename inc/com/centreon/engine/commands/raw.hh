@@ -51,6 +51,9 @@ namespace               commands {
                         raw(raw const& right);
                         ~raw() throw ();
     raw&                operator=(raw const& right);
+    static void         build_environment(
+                          nagios_macros& macros,
+                          environment& env);
     command*            clone() const;
     unsigned long       run(
                           std::string const& process_cmd,
@@ -61,6 +64,11 @@ namespace               commands {
                           nagios_macros& macros,
                           unsigned int timeout,
                           result& res);
+    void                run(
+                          std::string const& process_cmd,
+                          environment& env,
+                          unsigned int timeout,
+                          result& res);
 
   private:
     void                data_is_available(process& p) throw ();
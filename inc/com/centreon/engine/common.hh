@@ -345,6 +345,10 @@
 #  define STATE_CRITICAL 2
 #  define STATE_UNKNOWN  3
 
+/* Dependency failure states (bits of dependencies fail_states). */
+#  define DEPENDENCY_FAIL_ON_STATE(state) (1 << (state))
+#  define DEPENDENCY_FAIL_ON_PENDING      (1 << 4)
+
 /* State change types. */
 #  define HOST_STATECHANGE    0
 #  define SERVICE_STATECHANGE 1
@@ -72,9 +72,12 @@ namespace      configuration {
             break;
           }
 
-          if (first1->key() < first2->key())
+          // Keys are built once, some objects return them by value.
+          typename T::value_type::key_type const& key1(first1->key());
+          typename T::value_type::key_type const& key2(first2->key());
+          if (key1 < key2)
             *del++ = *first1++;
-          else if (first1->key() != first2->key())
+          else if (key1 != key2)
             *add++ = *first2++;
           else if (*first1 != *first2) {
             *modif++ = *first2++;
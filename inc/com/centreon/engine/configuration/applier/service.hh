@@ -20,6 +20,10 @@
 #ifndef CCE_CONFIGURATION_APPLIER_SERVICE_HH
 #  define CCE_CONFIGURATION_APPLIER_SERVICE_HH
 
+#  include <map>
+#  include <set>
+#  include <string>
+#  include "com/centreon/engine/configuration/group.hh"
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/shared_ptr.hh"
 
@@ -49,8 +53,10 @@ namespace             configuration {
 
      private:
       void            _expand_service_memberships(
-                        configuration::service& obj,
-                        configuration::state& s);
+                        configuration::service const& obj,
+                        std::set<std::string> const& target_hosts,
+                        configuration::state const& s,
+                        std::map<std::string, set_pair_string>& memberships);
       void            _inherits_special_vars(
                         configuration::service& obj,
                         configuration::state const& s);
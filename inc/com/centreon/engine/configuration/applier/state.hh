@@ -208,6 +208,7 @@ namespace           configuration {
                       retention::state& state);
       template      <typename ConfigurationType, typename ApplierType>
       void          _expand(configuration::state& new_state);
+      void          _link_relations();
       void          _processing(
                       configuration::state& new_cfg,
                       bool waiting_thread,
@@ -63,6 +63,7 @@ namespace                  configuration {
     std::string const&     email() const throw ();
     bool                   host_notifications_enabled() const throw ();
     list_string const&     host_notification_commands() const throw ();
+    unsigned int           notification_digest_interval() const throw ();
     unsigned int           host_notification_options() const throw ();
     std::string const&     host_notification_period() const throw ();
     bool                   retain_nonstatus_information() const throw ();
@@ -93,6 +94,7 @@ namespace                  configuration {
     bool                   _set_host_notification_commands(std::string const& value);
     bool                   _set_host_notification_options(std::string const& value);
     bool                   _set_host_notification_period(std::string const& value);
+    bool                   _set_notification_digest_interval(unsigned int value);
     bool                   _set_retain_nonstatus_information(bool value);
     bool                   _set_retain_status_information(bool value);
     bool                   _set_pager(std::string const& value);
@@ -114,6 +116,7 @@ namespace                  configuration {
     group<list_string>     _host_notification_commands;
     opt<unsigned int>      _host_notification_options;
     std::string            _host_notification_period;
+    opt<unsigned int>      _notification_digest_interval;
     opt<bool>              _retain_nonstatus_information;
     opt<bool>              _retain_status_information;
     std::string            _pager;
@@ -25,6 +25,7 @@
 #  include <map>
 #  include <set>
 #  include <string>
+#  include <vector>
 #  include "com/centreon/engine/namespace.hh"
 #  include "com/centreon/engine/string.hh"
 #  include "com/centreon/shared_ptr.hh"
@@ -64,9 +65,13 @@ namespace                  configuration {
                              object const& right) const throw ();
     bool                   operator!=(
                              object const& right) const throw ();
+    static void            buffer_config_warnings(
+                             std::vector<std::string>* warnings);
     virtual void           check_validity() const = 0;
     static shared_ptr<object>
                            create(std::string const& type_name);
+    static void            log_config_warnings(
+                             std::vector<std::string> const& warnings);
     virtual void           merge(object const& obj) = 0;
     std::string const&     name() const throw ();
     virtual bool           parse(char const* key, char const* value);
@@ -100,6 +105,8 @@ namespace                  configuration {
       }
     };
 
+    static void            _add_config_warning(
+                             std::string const& message);
     bool                   _set_name(std::string const& value);
     bool                   _set_should_register(bool value);
     bool                   _set_templates(std::string const& value);
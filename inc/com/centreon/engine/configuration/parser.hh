@@ -22,6 +22,10 @@
 
 #  include <fstream>
 #  include <string>
+#  include <utility>
+#  include <vector>
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
 #  include "com/centreon/engine/configuration/command.hh"
 #  include "com/centreon/engine/configuration/connector.hh"
 #  include "com/centreon/engine/configuration/contact.hh"
@@ -70,8 +74,42 @@ namespace              configuration {
     void               parse(std::string const& path, state& config);
 
   private:
+    typedef void (parser::*job)(std::size_t index);
     typedef void (parser::*store)(object_ptr obj);
 
+    // Result of the parsing of an object definition file.
+    struct             object_file {
+      std::string      error;
+      std::vector<std::pair<object_ptr, unsigned int> >
+                       objects;
+      std::string      path;
+      std::vector<std::string>
+                       warnings;
+    };
+
+    // Result of the template resolution of an object.
+    struct             object_resolution {
+                       object_resolution(object* o = NULL) : obj(o) {}
+
+      std::string      error;
+      object*          obj;
+      std::vector<std::string>
+                       warnings;
+    };
+
+    class              worker : public concurrency::thread {
+    public:
+                       worker(parser& owner);
+                       ~worker() throw ();
+
+    private:
+                       worker(worker const& right);
+      worker&          operator=(worker const& right);
+      void             _run();
+
+      parser&          _owner;
+    };
+
                        parser(parser const& right);
     parser&            operator=(parser const& right);
     void               _add_object(object_ptr obj);
@@ -103,13 +141,22 @@ namespace              configuration {
     static void        _insert(
                          map_object const& from,
                          std::set<T>& to);
+    void               _list_directory_configuration(
+                         std::string const& path,
+                         std::vector<object_file>& files);
     std::string const& _map_object_type(
                          map_object const& objects) const throw ();
-    void               _parse_directory_configuration(std::string const& path);
+    void               _merge_object_file(object_file const& file);
     void               _parse_global_configuration(std::string const& path);
-    void               _parse_object_definitions(std::string const& path);
+    static void        _parse_object_definitions(
+                         object_file& file,
+                         unsigned int read_options);
+    void               _parse_object_file(std::size_t index);
     void               _parse_resource_file(std::string const& path);
+    void               _resolve_object(std::size_t index);
     void               _resolve_template();
+    void               _run_jobs(job j, std::size_t count);
+    void               _run_pending_jobs();
     void               _store_into_list(object_ptr obj);
     template<typename T, std::string const& (T::*ptr)() const throw ()>
     void               _store_into_map(object_ptr obj);
@@ -117,11 +164,19 @@ namespace              configuration {
     state*             _config;
     unsigned int       _current_line;
     std::string        _current_path;
+    std::vector<object_file>
+                       _files;
+    job                _job;
+    std::size_t        _job_count;
+    concurrency::mutex _jobs_lock;
     list_object        _lst_objects[15];
     map_object         _map_objects[15];
+    std::size_t        _next_job;
     umap<object*, file_info>
                        _objects_info;
     unsigned int       _read_options;
+    std::vector<object_resolution>
+                       _resolutions;
     static store       _store[];
     map_object         _templates[15];
   };
@@ -0,0 +1,94 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_SETTER_INDEX_HH
+#  define CCE_CONFIGURATION_SETTER_INDEX_HH
+
+#  include <algorithm>
+#  include <cstddef>
+#  include <cstring>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace            configuration {
+  /**
+   *  @class setter_index setter_index.hh "com/centreon/engine/configuration/setter_index.hh"
+   *  @brief Find setters of a setter table by name.
+   *
+   *  Setter tables are written in a human-friendly order. The index
+   *  sorts them by name once, so that each attribute of each object
+   *  is looked up with a binary search instead of a linear scan. T is
+   *  the setter type, that must have a 'name' member.
+   */
+  template <typename T>
+  class              setter_index {
+  public:
+    /**
+     *  Constructor.
+     *
+     *  @param[in] table  Setter table.
+     */
+    template <std::size_t N>
+                     setter_index(T const (&table)[N]) {
+      _setters.reserve(N);
+      for (std::size_t i(0); i < N; ++i)
+        _setters.push_back(table + i);
+      // A stable sort keeps the first one of setters with the same
+      // name, like a linear scan.
+      std::stable_sort(_setters.begin(), _setters.end(), &_less);
+    }
+
+    /**
+     *  Find a setter.
+     *
+     *  @param[in] name  Setter name.
+     *
+     *  @return The setter if found, NULL otherwise.
+     */
+    T const*         find(char const* name) const {
+      typename std::vector<T const*>::const_iterator
+        it(std::lower_bound(
+                 _setters.begin(),
+                 _setters.end(),
+                 name,
+                 &_less_name));
+      if ((it == _setters.end()) || strcmp((*it)->name, name))
+        return (NULL);
+      return (*it);
+    }
+
+  private:
+    static bool      _less(T const* left, T const* right) {
+      return (strcmp(left->name, right->name) < 0);
+    }
+
+    static bool      _less_name(T const* left, char const* name) {
+      return (strcmp(left->name, name) < 0);
+    }
+
+    std::vector<T const*>
+                     _setters;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_CONFIGURATION_SETTER_INDEX_HH
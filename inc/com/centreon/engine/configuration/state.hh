@@ -214,6 +214,7 @@ namespace               configuration {
     void                global_host_event_handler(std::string const& value);
     std::string const&  global_service_event_handler() const throw ();
     void                global_service_event_handler(std::string const& value);
+    bool                globals_equal(state const& right) const throw ();
     float               high_host_flap_threshold() const throw ();
     void                high_host_flap_threshold(float value);
     float               high_service_flap_threshold() const throw ();
@@ -294,8 +295,12 @@ namespace               configuration {
     void                max_parallel_service_checks(unsigned int value);
     unsigned int        max_service_check_spread() const throw ();
     void                max_service_check_spread(unsigned int value);
+    unsigned int        notification_queue_size() const throw ();
+    void                notification_queue_size(unsigned int value);
     unsigned int        notification_timeout() const throw ();
     void                notification_timeout(unsigned int value);
+    unsigned int        notification_workers() const throw ();
+    void                notification_workers(unsigned int value);
     bool                obsess_over_hosts() const throw ();
     void                obsess_over_hosts(bool value);
     bool                obsess_over_services() const throw ();
@@ -583,7 +588,9 @@ namespace               configuration {
     unsigned long       _max_log_file_size;
     unsigned int        _max_parallel_service_checks;
     unsigned int        _max_service_check_spread;
+    unsigned int        _notification_queue_size;
     unsigned int        _notification_timeout;
+    unsigned int        _notification_workers;
     bool                _obsess_over_hosts;
     bool                _obsess_over_services;
     std::string         _ochp_command;
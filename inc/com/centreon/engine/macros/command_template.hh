@@ -0,0 +1,94 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MACROS_COMMAND_TEMPLATE_HH
+#  define CCE_MACROS_COMMAND_TEMPLATE_HH
+
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/macros/defines.hh"
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/shared_ptr.hh"
+
+CCE_BEGIN()
+
+namespace                    macros {
+  /**
+   *  @class command_template command_template.hh "com/centreon/engine/macros/command_template.hh"
+   *  @brief Precompiled command line.
+   *
+   *  A command line is split once into a list of tokens (literal
+   *  text, standard macros, $ARGn$, $USERn$ and other macros). Each
+   *  expansion then is a single pass over this list that appends
+   *  macro values to the output buffer.
+   */
+  class                      command_template {
+  public:
+    typedef std::vector<command_template>
+                             argument_list;
+
+                             command_template();
+                             command_template(std::string const& line);
+                             command_template(command_template const& other);
+                             ~command_template() throw ();
+    command_template&        operator=(command_template const& other);
+    static void              clear_arguments();
+    void                     compile(std::string const& line);
+    void                     expand(
+                               nagios_macros* mac,
+                               std::string& output,
+                               int options = 0) const;
+    static shared_ptr<argument_list>
+                             get_arguments(
+                               char const* cmd,
+                               bool cache = false);
+    std::string const&       get_line() const throw ();
+
+  private:
+    enum                     token_type {
+      token_literal = 0,
+      token_standard,
+      token_argv,
+      token_user,
+      token_other
+    };
+
+    struct                   token {
+      token_type             type;
+      unsigned int           id;
+      int                    clean_options;
+      std::string            text;
+      std::string            arg1;
+      std::string            arg2;
+      bool                   has_arg1;
+      bool                   has_arg2;
+    };
+
+    void                     _add_literal(char const* text, size_t size);
+    void                     _add_macro(std::string const& name);
+
+    std::string              _line;
+    size_t                   _literal_size;
+    std::vector<token>       _tokens;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_MACROS_COMMAND_TEMPLATE_HH
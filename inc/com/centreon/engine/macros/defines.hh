@@ -197,7 +197,9 @@
 # define MACRO_SERVICETIMEZONE                  158
 # define MACRO_CONTACTTIMEZONE                  159
 # define MACRO_CONTACTTOKEN                     160  
-# define MACRO_X_COUNT                          161  // size of macro_x[] array
+# define MACRO_NOTIFICATIONDIGEST               161
+# define MACRO_NOTIFICATIONDIGESTCOUNT          162
+# define MACRO_X_COUNT                          163  // size of macro_x[] array
 
 // Macro Cleaning Options
 # define STRIP_ILLEGAL_MACRO_CHARS              1
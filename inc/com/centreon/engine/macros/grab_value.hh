@@ -54,6 +54,18 @@ int grab_macrox_value(
 
 #  ifdef __cplusplus
 }
+
+#    include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace macros {
+  int  find_macrox(char const* name);
+  int  get_macrox_clean_options(unsigned int macro_type);
+}
+
+CCE_END()
+
 #  endif // C++
 
 #endif // !CCE_MACROS_GRAB_VALUE_HH
@@ -0,0 +1,134 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_MACROS_SUMMARY_HH
+#  define CCE_MACROS_SUMMARY_HH
+
+#  include <set>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/contact.hh"
+#  include "com/centreon/engine/objects/contactgroupsmember.hh"
+#  include "com/centreon/engine/objects/contactsmember.hh"
+#  include "com/centreon/engine/objects/host.hh"
+#  include "com/centreon/engine/objects/service.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace                  macros {
+  /**
+   *  @class summary summary.hh "com/centreon/engine/macros/summary.hh"
+   *  @brief Host and service state totals.
+   *
+   *  Totals used by the summary macros ($TOTALHOSTSUP$,
+   *  $TOTALSERVICESCRITICAL$, ...) and by the host service macros
+   *  ($TOTALHOSTSERVICESOK$, ...). They are updated each time the
+   *  status of a host or a service is updated, both globally and for
+   *  each contact of the object.
+   */
+  class                    summary {
+  public:
+    struct                 totals {
+      unsigned int         hosts_up;
+      unsigned int         hosts_down;
+      unsigned int         hosts_down_unhandled;
+      unsigned int         hosts_unreachable;
+      unsigned int         hosts_unreachable_unhandled;
+      unsigned int         services_ok;
+      unsigned int         services_warning;
+      unsigned int         services_warning_unhandled;
+      unsigned int         services_unknown;
+      unsigned int         services_unknown_unhandled;
+      unsigned int         services_critical;
+      unsigned int         services_critical_unhandled;
+    };
+
+    struct                 host_services {
+      unsigned int         total;
+      unsigned int         ok;
+      unsigned int         warning;
+      unsigned int         unknown;
+      unsigned int         critical;
+    };
+
+    host_services const&   get_host_services(host* hst) const;
+    totals const&          get_totals(contact* cntct = NULL) const;
+    static summary&        instance();
+    static void            load();
+    void                   rebuild();
+    static void            unload();
+    void                   update(host* hst);
+    void                   update(service* svc);
+
+  private:
+    enum                   state {
+      state_none = 0,
+      state_host_up,
+      state_host_down,
+      state_host_down_unhandled,
+      state_host_unreachable,
+      state_host_unreachable_unhandled,
+      state_service_ok,
+      state_service_warning,
+      state_service_warning_unhandled,
+      state_service_unknown,
+      state_service_unknown_unhandled,
+      state_service_critical,
+      state_service_critical_unhandled
+    };
+
+    struct                 service_info {
+      state                summary_state;
+      int                  current_state;
+    };
+
+                           summary();
+                           summary(summary const& other);
+                           ~summary() throw ();
+    summary&               operator=(summary const& other);
+    static void            _add(totals& t, state s, int count);
+    void                   _add_host_service(
+                             host* hst,
+                             int current_state,
+                             int count);
+    static state           _get_state(host const& hst);
+    static state           _get_state(service const& svc);
+    static void            _get_contacts(
+                             contactsmember* contacts,
+                             contactgroupsmember* groups,
+                             std::set<contact*>& result);
+    void                   _move(
+                             state old_state,
+                             state new_state,
+                             std::set<contact*> const& contacts);
+
+    umap<contact*, totals> _contact_totals;
+    umap<host*, host_services>
+                           _host_services;
+    umap<host*, state>     _hosts;
+    static summary*        _instance;
+    umap<service*, service_info>
+                           _services;
+    totals                 _totals;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_MACROS_SUMMARY_HH
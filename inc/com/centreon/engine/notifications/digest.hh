@@ -0,0 +1,81 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_NOTIFICATIONS_DIGEST_HH
+#  define CCE_NOTIFICATIONS_DIGEST_HH
+
+#  include <ctime>
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/objects/contact.hh"
+#  include "com/centreon/unordered_hash.hh"
+
+CCE_BEGIN()
+
+namespace              notifications {
+  /**
+   *  @class digest digest.hh "com/centreon/engine/notifications/digest.hh"
+   *  @brief Coalesce the notifications of a contact.
+   *
+   *  Contacts with a notification_digest_interval do not run their
+   *  notification commands for each notification. Notifications are
+   *  summarized in a batch which is sent at the end of the interval,
+   *  with a single run of each notification command of the contact.
+   *  The summary is available in the $NOTIFICATIONDIGEST$ macro, one
+   *  line per notification. Lines are separated by an escaped newline
+   *  (\\n), as in long plugin output, because macros of notification
+   *  commands are stripped of control characters.
+   */
+  class                digest {
+  public:
+    void               flush(time_t now);
+    void               flush_all();
+    static digest&     instance();
+    static void        load();
+    bool               push(
+                         contact* cntct,
+                         int notification_type,
+                         std::string const& item);
+    static void        unload();
+
+  private:
+    struct             batch {
+      time_t           deadline;
+      std::vector<std::string>
+                       items[2];
+    };
+
+                       digest();
+                       digest(digest const& right);
+                       ~digest() throw ();
+    digest&            operator=(digest const& right);
+    static void        _send(
+                         std::string const& contact_name,
+                         batch const& b);
+
+    umap<std::string, batch>
+                       _batches;
+    time_t             _next_deadline;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_NOTIFICATIONS_DIGEST_HH
@@ -0,0 +1,122 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_NOTIFICATIONS_DISPATCHER_HH
+#  define CCE_NOTIFICATIONS_DISPATCHER_HH
+
+#  include <deque>
+#  include <string>
+#  include <sys/time.h>
+#  include <vector>
+#  include "com/centreon/concurrency/condvar.hh"
+#  include "com/centreon/concurrency/mutex.hh"
+#  include "com/centreon/concurrency/thread.hh"
+#  include "com/centreon/engine/commands/environment.hh"
+#  include "com/centreon/engine/commands/result.hh"
+#  include "com/centreon/engine/macros/defines.hh"
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+namespace                notifications {
+  /**
+   *  @class dispatcher dispatcher.hh "com/centreon/engine/notifications/dispatcher.hh"
+   *  @brief Run notification commands out of the main thread.
+   *
+   *  Notification commands are prepared by the main thread (macro
+   *  expansion, environment) and pushed in a bounded queue served by
+   *  a pool of workers. Results are reaped by the main thread, which
+   *  is the only one to send system command data to the event broker.
+   *  When the queue is full, the main thread waits for a free slot.
+   *  Without workers (the default), commands are run synchronously.
+   */
+  class                  dispatcher {
+  public:
+    void                 configure(
+                           unsigned int workers,
+                           unsigned int queue_size);
+    static dispatcher&   instance();
+    static void          load();
+    void                 reap();
+    void                 run(
+                           nagios_macros& mac,
+                           std::string const& cmd,
+                           unsigned int timeout,
+                           std::string const& contact_name,
+                           int notification_type);
+    static void          unload();
+    void                 wait();
+
+  private:
+    struct               job {
+      std::string        command;
+      std::string        contact_name;
+      commands::environment
+                         env;
+      std::string        error;
+      int                notification_type;
+      commands::result   res;
+      timeval            start_time;
+      unsigned int       timeout;
+    };
+
+    class                worker : public concurrency::thread {
+    public:
+                         worker(dispatcher& owner);
+                         ~worker() throw ();
+
+    private:
+                         worker(worker const& right);
+      worker&            operator=(worker const& right);
+      void               _run();
+
+      dispatcher&        _owner;
+    };
+
+                         dispatcher();
+                         dispatcher(dispatcher const& right);
+                         ~dispatcher() throw ();
+    dispatcher&          operator=(dispatcher const& right);
+    static void          _execute(job& j);
+    void                 _finish(job& j);
+    void                 _log_stats() const;
+    void                 _start_workers(unsigned int count);
+    void                 _stop_workers();
+    void                 _work();
+
+    unsigned long long   _blocked;
+    unsigned long long   _dispatched;
+    std::deque<job*>     _done;
+    concurrency::condvar _idle;
+    concurrency::mutex   _lock;
+    std::size_t          _max_depth;
+    concurrency::condvar _pending;
+    std::deque<job*>     _queue;
+    std::size_t          _queue_size;
+    unsigned int         _running;
+    concurrency::condvar _slot;
+    bool                 _stopping;
+    unsigned long long   _timed_out;
+    std::vector<worker*> _workers;
+  };
+}
+
+CCE_END()
+
+#endif // !CCE_NOTIFICATIONS_DISPATCHER_HH
@@ -75,6 +75,9 @@ typedef struct                  contact_struct {
 
 /* Other CONTACT structure. */
 struct                          contact_other_properties {
+                                contact_other_properties()
+    : notification_digest_interval(0) {}
+  unsigned int                  notification_digest_interval;
   std::string                   timezone;
 };
 
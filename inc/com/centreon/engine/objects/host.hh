@@ -23,6 +23,7 @@
 #  include <string>
 #  include <time.h>
 #  include "com/centreon/engine/common.hh"
+#  include "com/centreon/engine/state_history.hh"
 
 /* Forward declaration. */
 struct command_struct;
@@ -30,6 +31,8 @@ struct contact_struct;
 struct contactgroupsmember_struct;
 struct contactsmember_struct;
 struct customvariablesmember_struct;
+struct hostdependency_struct;
+struct hostescalation_struct;
 struct hostsmember_struct;
 struct objectlist_struct;
 struct servicesmember_struct;
@@ -155,6 +158,17 @@ typedef struct                  host_struct {
   objectlist_struct*            hostgroups_ptr;
   struct host_struct*           next;
   struct host_struct*           nexthash;
+
+  /* NULL-terminated, rebuilt by the configuration applier. */
+  hostdependency_struct**       dependencies_ptr;
+  hostescalation_struct**       escalations_ptr;
+
+  /* Maintained by update_host_reachability(). */
+  int                           counted_as_up;
+  unsigned int                  parents_up;
+
+  /* Maintained along with state_history. */
+  state_history_changes         state_changes;
 }                               host;
 
 /* Other HOST structure. */
@@ -42,6 +42,8 @@ typedef struct                  hostdependency_struct {
   timeperiod_struct*            dependency_period_ptr;
   struct hostdependency_struct* next;
   struct hostdependency_struct* nexthash;
+  /* DEPENDENCY_FAIL_ON_* mask built from the fail_on_* flags. */
+  unsigned int                  fail_states;
 }                               hostdependency;
 
 #  ifdef __cplusplus
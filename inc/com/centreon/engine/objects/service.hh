@@ -23,6 +23,7 @@
 #  include <string>
 #  include <time.h>
 #  include "com/centreon/engine/common.hh"
+#  include "com/centreon/engine/state_history.hh"
 
 /* Forward declaration. */
 struct command_struct;
@@ -31,6 +32,8 @@ struct contactsmember_struct;
 struct customvariablesmember_struct;
 struct host_struct;
 struct objectlist_struct;
+struct servicedependency_struct;
+struct serviceescalation_struct;
 struct timeperiod_struct;
 
 typedef struct                  service_struct {
@@ -145,6 +148,13 @@ typedef struct                  service_struct {
   objectlist_struct*            servicegroups_ptr;
   struct service_struct*        next;
   struct service_struct*        nexthash;
+
+  /* NULL-terminated, rebuilt by the configuration applier. */
+  servicedependency_struct**    dependencies_ptr;
+  serviceescalation_struct**    escalations_ptr;
+
+  /* Maintained along with state_history. */
+  state_history_changes         state_changes;
 }                               service;
 
 /* Other SERVICE structure. */
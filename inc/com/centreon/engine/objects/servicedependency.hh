@@ -45,6 +45,8 @@ typedef struct                     servicedependency_struct {
   timeperiod_struct*               dependency_period_ptr;
   struct servicedependency_struct* next;
   struct servicedependency_struct* nexthash;
+  /* DEPENDENCY_FAIL_ON_* mask built from the fail_on_* flags. */
+  unsigned int                     fail_states;
 }                                  servicedependency;
 
 #  ifdef __cplusplus
@@ -0,0 +1,58 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_STATE_HISTORY_HH
+#  define CCE_STATE_HISTORY_HH
+
+#  include "com/centreon/engine/common.hh"
+
+/*
+** State changes of a state history. Position x (from 1 to
+** MAX_STATE_HISTORY_ENTRIES - 1, 1 being the oldest) is a change
+** between entries x - 1 and x of the history, in chronological order.
+*/
+typedef struct state_history_changes_struct {
+  unsigned int count;     /* Number of changes. */
+  unsigned int mask;      /* Bit x - 1 is set if position x is a change. */
+  unsigned int positions; /* Sum of the positions of the changes. */
+}              state_history_changes;
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif // C++
+
+double get_state_history_percent_change(
+         state_history_changes const* changes,
+         double low_threshold,
+         double high_threshold);
+void   push_state_history(
+         int history[],
+         unsigned int* index,
+         state_history_changes* changes,
+         int state);
+void   rebuild_state_history_changes(
+         int const history[],
+         unsigned int index,
+         state_history_changes* changes);
+
+#  ifdef __cplusplus
+}
+#  endif // C++
+
+#endif // !CCE_STATE_HISTORY_HH
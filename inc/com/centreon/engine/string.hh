@@ -80,6 +80,8 @@ namespace                 string {
     return (oss.str());
   }
 
+  char*                   intern(char const* value);
+
   inline char const*      setstr(char*& buf, char const* value = NULL) {
     delete[] buf;
     return ((buf = string::dup(value)));
@@ -217,6 +219,7 @@ namespace                 string {
   std::string&            trim(std::string& str) throw ();
   std::string&            trim_left(std::string& str) throw ();
   std::string&            trim_right(std::string& str) throw ();
+  void                    unintern(char const* value) throw ();
 }
 
 CCE_END()
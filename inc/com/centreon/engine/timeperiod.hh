@@ -28,6 +28,7 @@ extern "C" {
 int  check_time_against_period(
        time_t test_time,
        timeperiod* tperiod);
+void clear_timeperiod_calendars();
 void get_next_valid_time(
        time_t pref_time,
        time_t* valid_time,
@@ -0,0 +1,96 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_TIMEZONE_INFO_HH
+#  define CCE_TIMEZONE_INFO_HH
+
+#  include <ctime>
+#  include <string>
+#  include <vector>
+#  include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class timezone_info timezone_info.hh "com/centreon/engine/timezone_info.hh"
+ *  @brief Timezone transition table.
+ *
+ *  Timezone loaded once from the zoneinfo database (or from a POSIX TZ
+ *  string) and able to convert time without touching the process
+ *  timezone. localtime() and mktime() of this class behave like their
+ *  libc counterparts when the TZ environment variable is set to the
+ *  name of this timezone, but they are reentrant and do not call
+ *  tzset().
+ */
+class                timezone_info {
+public:
+                     timezone_info(char const* tz = NULL);
+                     timezone_info(timezone_info const& other);
+                     ~timezone_info() throw ();
+  timezone_info&     operator=(timezone_info const& other);
+  std::string const& get_name() const throw ();
+  void               localtime(time_t t, struct tm* result) const;
+  time_t             mktime(struct tm* t) const;
+
+private:
+  struct             ttinfo {
+    std::string      abbreviation;
+    long             gmtoff;
+    bool             isdst;
+  };
+
+  struct             rule_date {
+    int              day;
+    int              month;
+    long             time;
+    char             type;
+    int              week;
+  };
+
+  void               _copy(timezone_info const& other);
+  bool               _find_offset(
+                       time_t local,
+                       bool isdst,
+                       long& gmtoff) const;
+  ttinfo const&      _find_ttinfo(time_t t) const;
+  bool               _load_file(std::string const& path);
+  bool               _parse_posix(char const* spec);
+  ttinfo const&      _rule_ttinfo(time_t t) const;
+  static time_t      _rule_transition(
+                       rule_date const& date,
+                       long year,
+                       long gmtoff);
+
+  rule_date          _dst_end;
+  rule_date          _dst_start;
+  bool               _has_rule;
+  std::string        _name;
+  ttinfo             _rule_dst;
+  ttinfo             _rule_std;
+  std::vector<time_t>
+                     _transitions;
+  std::vector<ttinfo>
+                     _ttinfos;
+  std::vector<unsigned char>
+                     _types;
+};
+
+CCE_END()
+
+#endif // !CCE_TIMEZONE_INFO_HH
@@ -21,6 +21,7 @@
 #  define CCE_TIMEZONE_LOCKER_HH
 
 #  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/timezone_info.hh"
 
 CCE_BEGIN()
 
@@ -39,6 +40,9 @@ public:
 private:
                       timezone_locker(timezone_locker const& other);
   timezone_locker&    operator=(timezone_locker const& other);
+
+  timezone_info const*
+                      _previous;
 };
 
 CCE_END()
@@ -20,9 +20,11 @@
 #ifndef CCE_TIMEZONE_MANAGER_HH
 #  define CCE_TIMEZONE_MANAGER_HH
 
-#  include <stack>
 #  include <string>
+#  include "com/centreon/concurrency/mutex.hh"
 #  include "com/centreon/engine/namespace.hh"
+#  include "com/centreon/engine/timezone_info.hh"
+#  include "com/centreon/unordered_hash.hh"
 
 CCE_BEGIN()
 
@@ -31,13 +33,18 @@ CCE_BEGIN()
  *  @brief Manage timezone changes.
  *
  *  This class handle timezone change. This can either be setting a new
- *  timezone or restoring a previous one.
+ *  timezone or restoring a previous one. Timezones are loaded once and
+ *  the current timezone is only set for the calling thread, the
+ *  process timezone (TZ environment variable) is never modified.
  */
 class                      timezone_manager {
 public:
+  timezone_info const&     get_current() const;
+  timezone_info const*     get_timezone(char const* tz);
   static void              load();
-  void                     pop_timezone();
-  void                     push_timezone(char const* tz);
+  void                     pop_timezone(timezone_info const* previous);
+  timezone_info const*     push_timezone(char const* tz);
+  void                     reload();
   static void              unload();
 
   /**
@@ -50,21 +57,16 @@ public:
   }
 
 private:
-  struct                   tz_info {
-    bool                   is_set;
-    std::string            tz_name;
-  };
-
                            timezone_manager();
                            timezone_manager(timezone_manager const& other);
                            ~timezone_manager();
   timezone_manager&        operator=(timezone_manager const& other);
-  void                     _backup_timezone(tz_info* info);
-  void                     _set_timezone(char const* tz);
 
-  tz_info                  _base;
+  timezone_info            _base;
   static timezone_manager* _instance;
-  std::stack<tz_info>      _tz;
+  umap<std::string, timezone_info*>
+                           _timezones;
+  concurrency::mutex       _timezones_lock;
 };
 
 CCE_END()
@@ -166,6 +166,9 @@ int passive_host_checks_last_15min = 0;
 int active_cached_host_checks_last_1min = 0;
 int active_cached_host_checks_last_5min = 0;
 int active_cached_host_checks_last_15min = 0;
+int coalesced_host_checks_last_1min = 0;
+int coalesced_host_checks_last_5min = 0;
+int coalesced_host_checks_last_15min = 0;
 int parallel_host_checks_last_1min = 0;
 int parallel_host_checks_last_5min = 0;
 int parallel_host_checks_last_15min = 0;
@@ -188,6 +191,9 @@ int passive_service_checks_last_15min = 0;
 int active_cached_service_checks_last_1min = 0;
 int active_cached_service_checks_last_5min = 0;
 int active_cached_service_checks_last_15min = 0;
+int coalesced_service_checks_last_1min = 0;
+int coalesced_service_checks_last_5min = 0;
+int coalesced_service_checks_last_15min = 0;
 
 int external_commands_last_1min = 0;
 int external_commands_last_5min = 0;
@@ -497,6 +503,10 @@ int display_stats() {
          active_cached_host_checks_last_1min,
          active_cached_host_checks_last_5min,
          active_cached_host_checks_last_15min);
+  printf("   Coalesced:                           %d / %d / %d\n",
+         coalesced_host_checks_last_1min,
+         coalesced_host_checks_last_5min,
+         coalesced_host_checks_last_15min);
   printf("Passive Host Checks Last 1/5/15 min:    %d / %d / %d\n",
          passive_host_checks_last_1min,
 	 passive_host_checks_last_5min,
@@ -518,6 +528,10 @@ int display_stats() {
          active_cached_service_checks_last_1min,
          active_cached_service_checks_last_5min,
          active_cached_service_checks_last_15min);
+  printf("   Coalesced:                           %d / %d / %d\n",
+         coalesced_service_checks_last_1min,
+         coalesced_service_checks_last_5min,
+         coalesced_service_checks_last_15min);
   printf("Passive Service Checks Last 1/5/15 min: %d / %d / %d\n",
          passive_service_checks_last_1min,
          passive_service_checks_last_5min,
@@ -962,6 +976,14 @@ int read_status_file() {
           if ((temp_ptr = strtok(NULL, ",")))
             active_cached_host_checks_last_15min = atoi(temp_ptr);
         }
+        else if (!strcmp(var, "coalesced_host_check_stats")) {
+          if ((temp_ptr = strtok(val, ",")))
+            coalesced_host_checks_last_1min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            coalesced_host_checks_last_5min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            coalesced_host_checks_last_15min = atoi(temp_ptr);
+        }
         else if (!strcmp(var, "passive_host_check_stats")) {
           if ((temp_ptr = strtok(val, ",")))
             passive_host_checks_last_1min = atoi(temp_ptr);
@@ -994,6 +1016,14 @@ int read_status_file() {
           if ((temp_ptr = strtok(NULL, ",")))
             active_cached_service_checks_last_15min = atoi(temp_ptr);
         }
+        else if (!strcmp(var, "coalesced_service_check_stats")) {
+          if ((temp_ptr = strtok(val, ",")))
+            coalesced_service_checks_last_1min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            coalesced_service_checks_last_5min = atoi(temp_ptr);
+          if ((temp_ptr = strtok(NULL, ",")))
+            coalesced_service_checks_last_15min = atoi(temp_ptr);
+        }
         else if (!strcmp(var, "passive_service_check_stats")) {
           if ((temp_ptr = strtok(val, ",")))
             passive_service_checks_last_1min = atoi(temp_ptr);
@@ -1153,6 +1183,14 @@ int read_stats_file() {
       if ((temp_ptr = strtok(NULL, ",")))
         active_cached_host_checks_last_15min = atoi(temp_ptr);
     }
+    else if (!strcmp(var, "coalesced_host_check_stats")) {
+      if ((temp_ptr = strtok(val, ",")))
+        coalesced_host_checks_last_1min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        coalesced_host_checks_last_5min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        coalesced_host_checks_last_15min = atoi(temp_ptr);
+    }
     else if (!strcmp(var, "passive_host_check_stats")) {
       if ((temp_ptr = strtok(val, ",")))
         passive_host_checks_last_1min = atoi(temp_ptr);
@@ -1185,6 +1223,14 @@ int read_stats_file() {
       if ((temp_ptr = strtok(NULL, ",")))
         active_cached_service_checks_last_15min = atoi(temp_ptr);
     }
+    else if (!strcmp(var, "coalesced_service_check_stats")) {
+      if ((temp_ptr = strtok(val, ",")))
+        coalesced_service_checks_last_1min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        coalesced_service_checks_last_5min = atoi(temp_ptr);
+      if ((temp_ptr = strtok(NULL, ",")))
+        coalesced_service_checks_last_15min = atoi(temp_ptr);
+    }
     else if (!strcmp(var, "passive_service_check_stats")) {
       if ((temp_ptr = strtok(val, ",")))
         passive_service_checks_last_1min = atoi(temp_ptr);
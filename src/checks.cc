@@ -37,6 +37,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
@@ -604,6 +605,9 @@ int handle_async_service_check_result(
     }
   }
 
+  /* update totals of summary macros before notifications are sent */
+  com::centreon::engine::macros::summary::instance().update(temp_service);
+
   /**************************************/
   /******* SERVICE CHECK OK LOGIC *******/
   /**************************************/
@@ -1006,15 +1010,10 @@ int handle_async_service_check_result(
 
         /* check services that THIS ONE depends on for notification AND execution */
         /* we do this because we might be sending out a notification soon and we want the dependency logic to be accurate */
-        std::pair<std::string, std::string>
-          id(std::make_pair(temp_service->host_name, temp_service->description));
-        umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> > const&
-          dependencies(state::instance().servicedependencies());
-        for (umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> >::const_iterator
-               it(dependencies.find(id)), end(dependencies.end());
-             it != end && it->first == id;
-             ++it) {
-          servicedependency* temp_dependency(&*it->second);
+        for (servicedependency** sd(temp_service->dependencies_ptr);
+             sd && *sd;
+             ++sd) {
+          servicedependency* temp_dependency(*sd);
 
           if (temp_dependency->dependent_service_ptr == temp_service
               && temp_dependency->master_service_ptr != NULL) {
@@ -1228,9 +1227,21 @@ int handle_async_service_check_result(
         current_time);
     }
 
-    if (temp_service->is_executing == true)
+    /* a check is already running, all dependents will share its result */
+    else if (temp_service->is_executing == true) {
       run_async_check = false;
 
+      logger(dbg_checks, more)
+        << "Check of service '" << temp_service->description
+        << "' on host '" << temp_service->host_name
+        << "' coalesced with the running one.";
+
+      /* update check statistics */
+      update_check_stats(
+        COALESCED_SERVICE_CHECK_STATS,
+        current_time);
+    }
+
     if (run_async_check == true)
       run_async_service_check(
         temp_service,
@@ -1469,20 +1480,14 @@ unsigned int check_service_dependencies(
                int dependency_type) {
   service* temp_service = NULL;
   int state = STATE_OK;
+  unsigned int failing_states = 0;
   time_t current_time = 0L;
 
   logger(dbg_functions, basic)
     << "check_service_dependencies()";
 
-  std::pair<std::string, std::string>
-    id(svc->host_name, svc->description);
-  umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> > const&
-    dependencies(state::instance().servicedependencies());
-  for (umultimap<std::pair<std::string, std::string>, shared_ptr<servicedependency> >::const_iterator
-         it(dependencies.find(id)), end(dependencies.end());
-       it != end && it->first == id;
-       ++it) {
-    servicedependency* temp_dependency(&*it->second);
+  for (servicedependency** sd(svc->dependencies_ptr); sd && *sd; ++sd) {
+    servicedependency* temp_dependency(*sd);
 
     /* only check dependencies of the desired type (notification or execution) */
     if (temp_dependency->dependency_type != dependency_type)
@@ -1493,12 +1498,14 @@ unsigned int check_service_dependencies(
       continue;
 
     /* skip this dependency if it has a timeperiod and the current time isn't valid */
-    time(&current_time);
-    if (temp_dependency->dependency_period != NULL
-        && check_time_against_period(
-             current_time,
-             temp_dependency->dependency_period_ptr) == ERROR)
-      return (DEPENDENCIES_OK);
+    if (temp_dependency->dependency_period != NULL) {
+      if (!current_time)
+        time(&current_time);
+      if (check_time_against_period(
+            current_time,
+            temp_dependency->dependency_period_ptr) == ERROR)
+        return (DEPENDENCIES_OK);
+    }
 
     /* get the status to use (use last hard state if its currently in a soft state) */
     if (temp_service->state_type == SOFT_STATE
@@ -1508,19 +1515,10 @@ unsigned int check_service_dependencies(
       state = temp_service->current_state;
 
     /* is the service we depend on in state that fails the dependency tests? */
-    if (state == STATE_OK && temp_dependency->fail_on_ok == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_WARNING
-        && temp_dependency->fail_on_warning == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_UNKNOWN
-        && temp_dependency->fail_on_unknown == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == STATE_CRITICAL
-        && temp_dependency->fail_on_critical == true)
-      return (DEPENDENCIES_FAILED);
-    if ((state == STATE_OK && temp_service->has_been_checked == false)
-        && temp_dependency->fail_on_pending == true)
+    failing_states = DEPENDENCY_FAIL_ON_STATE(state);
+    if (state == STATE_OK && temp_service->has_been_checked == false)
+      failing_states |= DEPENDENCY_FAIL_ON_PENDING;
+    if (temp_dependency->fail_states & failing_states)
       return (DEPENDENCIES_FAILED);
 
     /* immediate dependencies ok at this point - check parent dependencies if necessary */
@@ -1959,21 +1957,15 @@ void schedule_host_check(host* hst, time_t check_time, int options) {
 unsigned int check_host_dependencies(host* hst, int dependency_type) {
   host* temp_host = NULL;
   int state = HOST_UP;
+  unsigned int failing_states = 0;
   time_t current_time = 0L;
 
   logger(dbg_functions, basic)
     << "check_host_dependencies()";
 
-  std::string id(hst->name);
-  umultimap<std::string, shared_ptr<hostdependency> > const&
-    dependencies(state::instance().hostdependencies());
-
   /* check all dependencies... */
-  for (umultimap<std::string, shared_ptr<hostdependency> >::const_iterator
-         it(dependencies.find(id)), end(dependencies.end());
-       it != end && it->first == id;
-       ++it) {
-         hostdependency* temp_dependency(&*it->second);
+  for (hostdependency** hd(hst->dependencies_ptr); hd && *hd; ++hd) {
+    hostdependency* temp_dependency(*hd);
 
     /* only check dependencies of the desired type (notification or execution) */
     if (temp_dependency->dependency_type != dependency_type)
@@ -1984,12 +1976,14 @@ unsigned int check_host_dependencies(host* hst, int dependency_type) {
       continue;
 
     /* skip this dependency if it has a timeperiod and the current time isn't valid */
-    time(&current_time);
-    if (temp_dependency->dependency_period != NULL
-        && check_time_against_period(
-             current_time,
-             temp_dependency->dependency_period_ptr) == ERROR)
-      return (DEPENDENCIES_OK);
+    if (temp_dependency->dependency_period != NULL) {
+      if (!current_time)
+        time(&current_time);
+      if (check_time_against_period(
+            current_time,
+            temp_dependency->dependency_period_ptr) == ERROR)
+        return (DEPENDENCIES_OK);
+    }
 
     /* get the status to use (use last hard state if its currently in a soft state) */
     if (temp_host->state_type == SOFT_STATE
@@ -1999,15 +1993,10 @@ unsigned int check_host_dependencies(host* hst, int dependency_type) {
       state = temp_host->current_state;
 
     /* is the host we depend on in state that fails the dependency tests? */
-    if (state == HOST_UP && temp_dependency->fail_on_up == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == HOST_DOWN && temp_dependency->fail_on_down == true)
-      return (DEPENDENCIES_FAILED);
-    if (state == HOST_UNREACHABLE
-        && temp_dependency->fail_on_unreachable == true)
-      return (DEPENDENCIES_FAILED);
-    if ((state == HOST_UP && temp_host->has_been_checked == false)
-        && temp_dependency->fail_on_pending == true)
+    failing_states = DEPENDENCY_FAIL_ON_STATE(state);
+    if (state == HOST_UP && temp_host->has_been_checked == false)
+      failing_states |= DEPENDENCY_FAIL_ON_PENDING;
+    if (temp_dependency->fail_states & failing_states)
       return (DEPENDENCIES_FAILED);
 
     /* immediate dependencies ok at this point - check parent dependencies if necessary */
@@ -3197,14 +3186,10 @@ int process_host_check_result_3x(
             << "Propagating predictive dependency checks to hosts this "
             "one depends on...";
 
-          std::string id(hst->name);
-          umultimap<std::string, shared_ptr<hostdependency> > const&
-            dependencies(state::instance().hostdependencies());
-          for (umultimap<std::string, shared_ptr<hostdependency> >::const_iterator
-                 it(dependencies.find(id)), end(dependencies.end());
-                 it != end && it->first == id;
-                 ++it) {
-            hostdependency* temp_dependency(&*it->second);
+          for (hostdependency** hd(hst->dependencies_ptr);
+               hd && *hd;
+               ++hd) {
+            hostdependency* temp_dependency(*hd);
             if (temp_dependency->dependent_host_ptr == hst
                 && temp_dependency->master_host_ptr != NULL) {
               master_host = (host*)temp_dependency->master_host_ptr;
@@ -3227,6 +3212,9 @@ int process_host_check_result_3x(
     << ", Type=" << (hst->state_type == HARD_STATE ? "HARD" : "SOFT")
     << ", Final State=" << hst->current_state;
 
+  /* children now see the final state of this host */
+  update_host_reachability(hst);
+
   /* handle the host state */
   handle_host_state(hst);
 
@@ -3323,8 +3311,24 @@ int process_host_check_result_3x(
     if (use_cached_result == true
         && (static_cast<unsigned long>(current_time - temp_host->last_check) <= check_timestamp_horizon))
       run_async_check = false;
-    if (temp_host->is_executing == true)
+
+    /* a check is already running or was just run, all dependents */
+    /* will share its result */
+    else if (temp_host->is_executing == true
+             || (temp_host->has_been_checked == true
+                 && temp_host->last_check == current_time)) {
       run_async_check = false;
+
+      logger(dbg_checks, more)
+        << "Check of host '" << temp_host->name
+        << "' coalesced with the "
+        << (temp_host->is_executing ? "running" : "last") << " one.";
+
+      /* update check statistics */
+      update_check_stats(
+        COALESCED_HOST_CHECK_STATS,
+        current_time);
+    }
     if (run_async_check == true)
       run_async_host_check_3x(
         temp_host,
@@ -3450,8 +3454,6 @@ int adjust_host_check_attempt_3x(host* hst, int is_active) {
 /* determination of the host's state based on route availability*//* used only to determine difference between DOWN and UNREACHABLE states */
 int determine_host_reachability(host* hst) {
   int state = HOST_DOWN;
-  host* parent_host = NULL;
-  hostsmember* temp_hostsmember = NULL;
 
   logger(dbg_functions, basic)
     << "determine_host_reachability()";
@@ -3477,33 +3479,66 @@ int determine_host_reachability(host* hst) {
       << "Host has no parents, so it is DOWN.";
   }
 
-  /* check all parent hosts to see if we're DOWN or UNREACHABLE */
+  /* at least one parent host is UP, so we're DOWN */
+  else if (hst->parents_up > 0) {
+    state = HOST_DOWN;
+    logger(dbg_checks, most)
+      << "At least one parent (" << hst->parents_up
+      << " in total) is up, so host is DOWN.";
+  }
+
+  /* no parents were up, so this host is UNREACHABLE */
   else {
+    state = HOST_UNREACHABLE;
+    logger(dbg_checks, most)
+      << "No parents were up, so host is UNREACHABLE.";
+  }
 
-    for (temp_hostsmember = hst->parent_hosts;
-	 temp_hostsmember != NULL;
-         temp_hostsmember = temp_hostsmember->next) {
+  return (state);
+}
 
-      if ((parent_host = temp_hostsmember->host_ptr) == NULL)
-        continue;
+/**
+ *  Recount the UP parents of all hosts. Must be called when host
+ *  parents are modified.
+ */
+void rebuild_host_reachability() {
+  logger(dbg_functions, basic)
+    << "rebuild_host_reachability()";
 
-      /* bail out as soon as we find one parent host that is UP */
-      if (parent_host->current_state == HOST_UP) {
-        /* set the current state */
-        state = HOST_DOWN;
-        logger(dbg_checks, most)
-          << "At least one parent (" << parent_host->name
-          << ") is up, so host is DOWN.";
-        break;
-      }
-    }
-    /* no parents were up, so this host is UNREACHABLE */
-    if (temp_hostsmember == NULL) {
-      state = HOST_UNREACHABLE;
-      logger(dbg_checks, most)
-        << "No parents were up, so host is UNREACHABLE.";
-    }
+  for (host* hst(host_list); hst; hst = hst->next) {
+    hst->counted_as_up = false;
+    hst->parents_up = 0;
   }
+  for (host* hst(host_list); hst; hst = hst->next)
+    update_host_reachability(hst);
+  return ;
+}
 
-  return (state);
+/**
+ *  Account the current state of a host in the number of UP parents
+ *  of its children, which is used by determine_host_reachability().
+ *  Must be called once the state of the host is final.
+ *
+ *  @param[in] hst  Host.
+ */
+void update_host_reachability(host* hst) {
+  if (!hst)
+    return ;
+
+  int up(hst->current_state == HOST_UP);
+  if (up == hst->counted_as_up)
+    return ;
+  hst->counted_as_up = up;
+  for (hostsmember* member(hst->child_hosts);
+       member;
+       member = member->next) {
+    host* child_host(member->host_ptr);
+    if (!child_host)
+      continue;
+    if (up)
+      ++child_host->parents_up;
+    else if (child_host->parents_up > 0)
+      --child_host->parents_up;
+  }
+  return ;
 }
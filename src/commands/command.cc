@@ -19,7 +19,6 @@
 
 #include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/commands/command.hh"
-#include "com/centreon/engine/macros/grab.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
@@ -40,7 +39,8 @@ commands::command::command(
                      command_listener* listener)
   : _command_line(command_line),
     _listener(listener),
-    _name(name) {
+    _name(name),
+    _template(command_line) {
 
 }
 
@@ -108,6 +108,7 @@ std::string const& commands::command::get_name() const throw() {
 void commands::command::set_command_line(
                           std::string const& command_line) {
   _command_line = command_line;
+  _template.compile(command_line);
   return;
 }
 
@@ -143,6 +144,7 @@ commands::command& commands::command::operator=(commands::command const& right)
     _command_line = right._command_line;
     _listener = right._listener;
     _name = right._name;
+    _template = right._template;
   }
   return (*this);
 }
@@ -155,10 +157,8 @@ commands::command& commands::command::operator=(commands::command const& right)
  *  @return The processed command line.
  */
 std::string commands::command::process_cmd(nagios_macros* macros) const {
-  char* command_line = NULL;
-  process_macros_r(macros, _command_line.c_str(), &command_line, 0);
-  std::string processed_cmd(command_line);
-  delete[] command_line;
+  std::string processed_cmd;
+  _template.expand(macros, processed_cmd);
   return (processed_cmd);
 }
 
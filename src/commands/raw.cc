@@ -93,6 +93,19 @@ raw& raw::operator=(raw const& right) {
   return (*this);
 }
 
+/**
+ *  Build the environment of a command from macros.
+ *
+ *  @param[in,out] macros  The macros data struct.
+ *  @param[out]    env     The environment to fill.
+ */
+void raw::build_environment(
+            nagios_macros& macros,
+            environment& env) {
+  _build_environment_macros(macros, env);
+  return;
+}
+
 /**
  *  Get a pointer on a copy of the same object.
  *
@@ -164,6 +177,28 @@ void raw::run(
             nagios_macros& macros,
             unsigned int timeout,
             result& res) {
+  // Setup environement macros if is necessary.
+  environment env;
+  _build_environment_macros(macros, env);
+  run(processed_cmd, env, timeout, res);
+  return;
+}
+
+/**
+ *  Run a command with a prebuilt environment and wait the result.
+ *  Macros are not accessed, so this method can be called outside of
+ *  the main thread.
+ *
+ *  @param[in]  args    The command arguments.
+ *  @param[in]  env     The environment of the command.
+ *  @param[in]  timeout The command timeout.
+ *  @param[out] res     The result of the command.
+ */
+void raw::run(
+            std::string const& processed_cmd,
+            environment& env,
+            unsigned int timeout,
+            result& res) {
   logger(dbg_commands, basic)
     << "raw::run: cmd='" << processed_cmd << "', timeout=" << timeout;
 
@@ -174,10 +209,6 @@ void raw::run(
   logger(dbg_commands, basic)
     << "raw::run: id=" << command_id << ", process=" << &p;
 
-  // Setup environement macros if is necessary.
-  environment env;
-  _build_environment_macros(macros, env);
-
   // Start process.
   try {
     p.exec(processed_cmd.c_str(), env.data(), timeout);
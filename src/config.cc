@@ -26,6 +26,7 @@
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/command_template.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -691,6 +692,12 @@ int check_service(service* svc, int* w, int* e) {
   /* save the pointer to the check command for later */
   svc->check_command_ptr = temp_command;
 
+  /* compile check command arguments ahead of the first check */
+  if (temp_command != NULL)
+    macros::command_template::get_arguments(
+      svc->service_check_command,
+      true);
+
   // Check for sane recovery options.
   if (svc->notifications_enabled
       && svc->notify_on_recovery
@@ -892,6 +899,12 @@ int check_host(host* hst, int* w, int* e) {
     /* save the pointer to the check command for later */
     hst->check_command_ptr = temp_command;
 
+    /* compile check command arguments ahead of the first check */
+    if (temp_command != NULL)
+      macros::command_template::get_arguments(
+        hst->host_check_command,
+        true);
+
     delete[] buf;
   }
 
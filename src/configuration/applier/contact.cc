@@ -153,6 +153,8 @@ void applier::contact::add_object(configuration::contact const& obj) {
     throw (engine_error() << "Could not register contact '"
            << obj.contact_name() << "'");
   contact_other_props[obj.contact_name()].timezone = obj.timezone();
+  contact_other_props[obj.contact_name()].notification_digest_interval
+    = obj.notification_digest_interval();
 
   // Add all the host notification commands.
   for (list_string::const_iterator
@@ -348,6 +350,8 @@ void applier::contact::modify_object(
     c->retain_nonstatus_information,
     static_cast<int>(obj.retain_nonstatus_information()));
   contact_other_props[obj.contact_name()].timezone = obj.timezone();
+  contact_other_props[obj.contact_name()].notification_digest_interval
+    = obj.notification_digest_interval();
 
   // Host notification commands.
   if (obj.host_notification_commands()
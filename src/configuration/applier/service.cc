@@ -263,9 +263,12 @@ void applier::service::add_object(
  *  @param[in,out] s  State being applied.
  */
 void applier::service::expand_objects(configuration::state& s) {
-  // Browse all services.
+  // Browse all services. Instances and groups are built apart and
+  // only set in the configuration state once all services were
+  // expanded, so that the state is left unchanged on error.
   configuration::set_service expanded;
-  for (configuration::set_service::iterator
+  std::map<std::string, set_pair_string> memberships;
+  for (configuration::set_service::const_iterator
          it_svc(s.services().begin()),
          end_svc(s.services().end());
        it_svc != end_svc;
@@ -301,6 +304,16 @@ void applier::service::expand_objects(configuration::state& s) {
                      it2->members().begin(),
                      it2->members().end());
     }
+    if (target_hosts.empty())
+      continue ;
+
+    // Attributes shared by all instances.
+    configuration::service base(*it_svc);
+    base.hostgroups().clear();
+    base.hosts().clear();
+
+    // Expand memberships of all instances.
+    _expand_service_memberships(base, target_hosts, s, memberships);
 
     // Browse all target hosts.
     for (std::set<std::string>::const_iterator
@@ -309,14 +322,9 @@ void applier::service::expand_objects(configuration::state& s) {
          it != end;
          ++it) {
       // Create service instance.
-      configuration::service svc(*it_svc);
-      svc.hostgroups().clear();
-      svc.hosts().clear();
+      configuration::service svc(base);
       svc.hosts().insert(*it);
 
-      // Expand memberships.
-      _expand_service_memberships(svc, s);
-
       // Inherits special vars.
       _inherits_special_vars(svc, s);
 
@@ -325,8 +333,30 @@ void applier::service::expand_objects(configuration::state& s) {
     }
   }
 
-  // Set expanded services in configuration state.
+  // Add service instances to their service groups, each group is
+  // updated once.
+  configuration::set_servicegroup groups;
+  for (configuration::set_servicegroup::const_iterator
+         it(s.servicegroups().begin()),
+         end(s.servicegroups().end());
+       it != end;
+       ++it) {
+    std::map<std::string, set_pair_string>::const_iterator
+      it_members(memberships.find(it->servicegroup_name()));
+    if (it_members == memberships.end())
+      groups.insert(groups.end(), *it);
+    else {
+      configuration::servicegroup group(*it);
+      group.members().insert(
+                        it_members->second.begin(),
+                        it_members->second.end());
+      groups.insert(group);
+    }
+  }
+
+  // Set expanded services and groups in configuration state.
   s.services().swap(expanded);
+  s.servicegroups().swap(groups);
 
   return ;
 }
@@ -718,12 +748,17 @@ void applier::service::resolve_object(
 /**
  *  Expand service instance memberships.
  *
- *  @param[in]  obj Target service.
- *  @param[out] s   Configuration state.
+ *  @param[in]     obj          Service, without hosts.
+ *  @param[in]     target_hosts Hosts of the service instances.
+ *  @param[in]     s            Configuration state.
+ *  @param[in,out] memberships  Service instances to add to service
+ *                              groups, by group name.
  */
 void applier::service::_expand_service_memberships(
-                         configuration::service& obj,
-                         configuration::state& s) {
+                         configuration::service const& obj,
+                         std::set<std::string> const& target_hosts,
+                         configuration::state const& s,
+                         std::map<std::string, set_pair_string>& memberships) {
   // Browse service groups.
   for (set_string::const_iterator
          it(obj.servicegroups().begin()),
@@ -731,25 +766,22 @@ void applier::service::_expand_service_memberships(
        it != end;
        ++it) {
     // Find service group.
-    configuration::set_servicegroup::iterator
-      it_group(s.servicegroups_find(*it));
-    if (it_group == s.servicegroups().end())
+    if (s.servicegroups_find(*it) == s.servicegroups().end())
       throw (engine_error() << "Could not add service '"
              << obj.service_description() << "' of host '"
-             << *obj.hosts().begin()
+             << *target_hosts.begin()
              << "' to non-existing service group '" << *it << "'");
 
-    // Remove service group from state.
-    configuration::servicegroup backup(*it_group);
-    s.servicegroups().erase(it_group);
-
-    // Add service to service members.
-    backup.members().insert(std::make_pair(
-                                   *obj.hosts().begin(),
-                                   obj.service_description()));
-
-    // Reinsert service group.
-    s.servicegroups().insert(backup);
+    // Add service instances to service members.
+    set_pair_string& members(memberships[*it]);
+    for (std::set<std::string>::const_iterator
+           it_host(target_hosts.begin()),
+           end_host(target_hosts.end());
+         it_host != end_host;
+         ++it_host)
+      members.insert(std::make_pair(
+                            *it_host,
+                            obj.service_description()));
   }
 
   return ;
@@ -17,9 +17,12 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <unistd.h>
+#include <vector>
 #include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks.hh"
 #include "com/centreon/engine/commands/connector.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/command.hh"
@@ -45,9 +48,14 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros/command_template.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/retention/applier/state.hh"
 #include "com/centreon/engine/retention/state.hh"
+#include "com/centreon/engine/timeperiod.hh"
+#include "com/centreon/engine/timezone_manager.hh"
 #include "com/centreon/engine/version.hh"
 #include "com/centreon/engine/xpddefault.hh"
 #include "com/centreon/engine/xsddefault.hh"
@@ -60,6 +68,48 @@ using namespace com::centreon::engine::logging;
 static bool            has_already_been_loaded(false);
 static applier::state* _instance(NULL);
 
+/**
+ *  Build the table of the relations (dependencies or escalations) of
+ *  an object.
+ *
+ *  @param[in] relations  Relations of all objects.
+ *  @param[in] key        Object key.
+ *
+ *  @return NULL-terminated table of the relations of the object, NULL
+ *          if the object has no relation.
+ */
+template <typename Key, typename Relation>
+static Relation** build_relation_table(
+                    umultimap<Key, shared_ptr<Relation> > const& relations,
+                    Key const& key) {
+  typedef typename umultimap<Key, shared_ptr<Relation> >::const_iterator
+    iterator;
+  std::pair<iterator, iterator> range(relations.equal_range(key));
+  std::vector<Relation*> related;
+  for (iterator it(range.first); it != range.second; ++it)
+    related.push_back(it->second.get());
+  if (related.empty())
+    return (NULL);
+  Relation** table(new Relation*[related.size() + 1]);
+  std::copy(related.begin(), related.end(), table);
+  table[related.size()] = NULL;
+  return (table);
+}
+
+/**
+ *  Check that a difference is empty.
+ *
+ *  @param[in] diff  Difference between two sets of objects.
+ *
+ *  @return True if no object was added, deleted or modified.
+ */
+template <typename T>
+static bool is_empty(applier::difference<T> const& diff) {
+  return (diff.added().empty()
+          && diff.deleted().empty()
+          && diff.modified().empty());
+}
+
 /**
  *  Apply new configuration.
  *
@@ -1098,7 +1148,9 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->max_log_file_size(new_cfg.max_log_file_size());
   config->max_parallel_service_checks(new_cfg.max_parallel_service_checks());
   config->max_service_check_spread(new_cfg.max_service_check_spread());
+  config->notification_queue_size(new_cfg.notification_queue_size());
   config->notification_timeout(new_cfg.notification_timeout());
+  config->notification_workers(new_cfg.notification_workers());
   config->obsess_over_hosts(new_cfg.obsess_over_hosts());
   config->obsess_over_services(new_cfg.obsess_over_services());
   config->ochp_command(new_cfg.ochp_command());
@@ -1366,6 +1418,39 @@ void applier::state::_expand(configuration::state& new_state) {
   return ;
 }
 
+/**
+ *  Rebuild the dependency and escalation tables of all hosts and
+ *  services, so that notification and check code does not have to
+ *  look them up.
+ */
+void applier::state::_link_relations() {
+  for (umap<std::string, shared_ptr<host_struct> >::iterator
+         it(_hosts.begin()), end(_hosts.end());
+       it != end;
+       ++it) {
+    host_struct* hst(it->second.get());
+    delete[] hst->dependencies_ptr;
+    hst->dependencies_ptr
+      = build_relation_table(_hostdependencies, it->first);
+    delete[] hst->escalations_ptr;
+    hst->escalations_ptr
+      = build_relation_table(_hostescalations, it->first);
+  }
+  for (umap<std::pair<std::string, std::string>, shared_ptr<service_struct> >::iterator
+         it(_services.begin()), end(_services.end());
+       it != end;
+       ++it) {
+    service_struct* svc(it->second.get());
+    delete[] svc->dependencies_ptr;
+    svc->dependencies_ptr
+      = build_relation_table(_servicedependencies, it->first);
+    delete[] svc->escalations_ptr;
+    svc->escalations_ptr
+      = build_relation_table(_serviceescalations, it->first);
+  }
+  return ;
+}
+
 /**
  *  Process new configuration and apply it.
  *
@@ -1527,6 +1612,27 @@ void applier::state::_processing(
     config->serviceescalations(),
     new_cfg.serviceescalations());
 
+  // Check whether the reload changes anything. Objects were already
+  // compared by the differences above, only globals remain.
+  bool unchanged(
+         has_already_been_loaded
+         && !verify_config
+         && !test_scheduling
+         && is_empty(diff_timeperiods)
+         && is_empty(diff_connectors)
+         && is_empty(diff_commands)
+         && is_empty(diff_contacts)
+         && is_empty(diff_contactgroups)
+         && is_empty(diff_hosts)
+         && is_empty(diff_hostgroups)
+         && is_empty(diff_services)
+         && is_empty(diff_servicegroups)
+         && is_empty(diff_hostdependencies)
+         && is_empty(diff_servicedependencies)
+         && is_empty(diff_hostescalations)
+         && is_empty(diff_serviceescalations)
+         && config->globals_equal(new_cfg));
+
   // Timing.
   gettimeofday(tv + 1, NULL);
 
@@ -1538,6 +1644,19 @@ void applier::state::_processing(
     _processing_state = state_apply;
   }
 
+  // Nothing to apply, objects, globals and scheduling are kept as
+  // they are. Timezones and modules are still reloaded, they do not
+  // depend only on the configuration files.
+  if (unchanged) {
+    logger(log_info_message, basic)
+      << "Configuration did not change, only modules are reloaded";
+    clear_timeperiod_calendars();
+    timezone_manager::instance().reload();
+    neb_reload_all_modules();
+    _processing_state = state_ready;
+    return ;
+  }
+
   try {
     // Apply logging configurations.
     applier::logging::instance().apply(new_cfg);
@@ -1548,6 +1667,9 @@ void applier::state::_processing(
     // Apply macros configurations.
     applier::macros::instance().apply(new_cfg);
 
+    // Drop compiled command arguments of the previous configuration.
+    engine::macros::command_template::clear_arguments();
+
     // Timing.
     gettimeofday(tv + 2, NULL);
 
@@ -1577,6 +1699,11 @@ void applier::state::_processing(
     _resolve<configuration::timeperiod, applier::timeperiod>(
       config->timeperiods());
 
+    // Drop compiled calendars of the previous timeperiods, and the
+    // timezones they refer to.
+    clear_timeperiod_calendars();
+    timezone_manager::instance().reload();
+
     // Apply connectors.
     _apply<configuration::connector, applier::connector>(
       diff_connectors);
@@ -1645,10 +1772,19 @@ void applier::state::_processing(
     _resolve<configuration::serviceescalation, applier::serviceescalation>(
       config->serviceescalations());
 
+    // Attach dependencies and escalations to hosts and services.
+    _link_relations();
+
     // Load retention.
     if (state)
       _apply(new_cfg, *state);
 
+    // Count UP parents of hosts, now that their states are known.
+    rebuild_host_reachability();
+
+    // Compute totals of summary macros.
+    engine::macros::summary::instance().rebuild();
+
     // Apply scheduler.
     if (!verify_config)
       applier::scheduler::instance().apply(
@@ -1670,6 +1806,12 @@ void applier::state::_processing(
       }
     }
 
+    // Apply notification dispatcher settings.
+    if (!verify_config && !test_scheduling)
+      engine::notifications::dispatcher::instance().configure(
+        config->notification_workers(),
+        config->notification_queue_size());
+
     // Timing.
     gettimeofday(tv + 3, NULL);
 
@@ -20,6 +20,7 @@
 #include "com/centreon/engine/configuration/contact.hh"
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -44,6 +45,7 @@ contact::setters const contact::_setters[] = {
   { "service_notification_period",   SETTER(std::string const&, _set_service_notification_period) },
   { "service_notification_commands", SETTER(std::string const&, _set_service_notification_commands) },
   { "host_notification_options",     SETTER(std::string const&, _set_host_notification_options) },
+  { "notification_digest_interval",  SETTER(unsigned int, _set_notification_digest_interval) },
   { "service_notification_options",  SETTER(std::string const&, _set_service_notification_options) },
   { "host_notifications_enabled",    SETTER(bool, _set_host_notifications_enabled) },
   { "service_notifications_enabled", SETTER(bool, _set_service_notifications_enabled) },
@@ -57,6 +59,7 @@ contact::setters const contact::_setters[] = {
 static bool const           default_can_submit_commands(true);
 static bool const           default_host_notifications_enabled(true);
 static unsigned short const default_host_notification_options(host::none);
+static unsigned int const   default_notification_digest_interval(0);
 static bool const           default_retain_nonstatus_information(true);
 static bool const           default_retain_status_information(true);
 static unsigned short const default_service_notification_options(service::none);
@@ -75,6 +78,7 @@ contact::contact(key_type const& key)
     _contact_name(key),
     _host_notifications_enabled(default_host_notifications_enabled),
     _host_notification_options(default_host_notification_options),
+    _notification_digest_interval(default_notification_digest_interval),
     _retain_nonstatus_information(default_retain_nonstatus_information),
     _retain_status_information(default_retain_status_information),
     _service_notification_options(default_service_notification_options),
@@ -117,6 +121,7 @@ contact& contact::operator=(contact const& other) {
     _host_notification_commands = other._host_notification_commands;
     _host_notification_options = other._host_notification_options;
     _host_notification_period = other._host_notification_period;
+    _notification_digest_interval = other._notification_digest_interval;
     _retain_nonstatus_information = other._retain_nonstatus_information;
     _retain_status_information = other._retain_status_information;
     _pager = other._pager;
@@ -150,6 +155,7 @@ bool contact::operator==(contact const& other) const throw () {
           && _host_notification_commands == other._host_notification_commands
           && _host_notification_options == other._host_notification_options
           && _host_notification_period == other._host_notification_period
+          && _notification_digest_interval == other._notification_digest_interval
           && _retain_nonstatus_information == other._retain_nonstatus_information
           && _retain_status_information == other._retain_status_information
           && _pager == other._pager
@@ -210,6 +216,10 @@ bool contact::operator<(contact const& other) const throw () {
            != other._host_notification_period)
     return (_host_notification_period
             < other._host_notification_period);
+  else if (_notification_digest_interval
+           != other._notification_digest_interval)
+    return (_notification_digest_interval
+            < other._notification_digest_interval);
   else if (_retain_nonstatus_information
            != other._retain_nonstatus_information)
     return (_retain_nonstatus_information
@@ -284,6 +294,7 @@ void contact::merge(object const& obj) {
   MRG_INHERIT(_host_notification_commands);
   MRG_OPTION(_host_notification_options);
   MRG_DEFAULT(_host_notification_period);
+  MRG_OPTION(_notification_digest_interval);
   MRG_OPTION(_retain_nonstatus_information);
   MRG_OPTION(_retain_status_information);
   MRG_DEFAULT(_pager);
@@ -304,11 +315,10 @@ void contact::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool contact::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   if (!strncmp(key, ADDRESS_PROPERTY, sizeof(ADDRESS_PROPERTY) - 1))
     return (_set_address(key + sizeof(ADDRESS_PROPERTY) - 1, value));
   else if (key[0] == '_') {
@@ -426,6 +436,15 @@ std::string const& contact::host_notification_period() const throw () {
   return (_host_notification_period);
 }
 
+/**
+ *  Get notification_digest_interval.
+ *
+ *  @return The notification_digest_interval.
+ */
+unsigned int contact::notification_digest_interval() const throw () {
+  return (_notification_digest_interval);
+}
+
 /**
  *  Get retain_nonstatus_information.
  *
@@ -662,6 +681,18 @@ bool contact::_set_host_notification_period(std::string const& value) {
   return (true);
 }
 
+/**
+ *  Set notification_digest_interval value.
+ *
+ *  @param[in] value The new notification_digest_interval value.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool contact::_set_notification_digest_interval(unsigned int value) {
+  _notification_digest_interval = value;
+  return (true);
+}
+
 /**
  *  Set retain_nonstatus_information value.
  *
@@ -19,17 +19,15 @@
 
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/configuration/hostextinfo.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
-#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
-using namespace com::centreon::engine::logging;
 
 #define SETTER(type, method) \
   &object::setter<host, type, &host::method>::generic
@@ -522,11 +520,10 @@ void host::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool host::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   if (key[0] == '_') {
     _customvariables[key + 1] = value;
     return (true);
@@ -1250,9 +1247,8 @@ bool host::_set_event_handler_enabled(bool value) {
  */
 bool host::_set_failure_prediction_enabled(bool value) {
   (void)value;
-  logger(log_config_warning, basic)
-    << "Warning: host failure_prediction_enabled was ignored";
-  ++config_warnings;
+  _add_config_warning(
+    "Warning: host failure_prediction_enabled was ignored");
   return (true);
 }
 
@@ -1266,9 +1262,8 @@ bool host::_set_failure_prediction_enabled(bool value) {
 bool host::_set_failure_prediction_options(
        std::string const& value) {
   (void)value;
-  logger(log_config_warning, basic)
-    << "Warning: service failure_prediction_options was ignored";
-  ++config_warnings;
+  _add_config_warning(
+    "Warning: service failure_prediction_options was ignored");
   return (true);
 }
 
@@ -18,16 +18,14 @@
 */
 
 #include "com/centreon/engine/configuration/hostdependency.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
-#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
 using namespace com::centreon::engine::configuration;
-using namespace com::centreon::engine::logging;
 
 #define SETTER(type, method) \
   &object::setter<hostdependency, type, &hostdependency::method>::generic
@@ -184,17 +182,16 @@ void hostdependency::check_validity() const {
            << "respectively)");
 
   if (!_execution_failure_options && !_notification_failure_options) {
-    ++config_warnings;
     std::string host_name(!_hosts->empty()
                           ? *_hosts->begin()
                           : *_hostgroups->begin());
     std::string dependend_host_name(!_dependent_hosts->empty()
                                     ? *_dependent_hosts->begin()
                                     : *_dependent_hostgroups->begin());
-    logger(log_config_warning, basic)
-      << "Warning: Ignoring lame host dependency of '"
-      << dependend_host_name << "' on host/hostgroups '"
-      << host_name << "'.";
+    _add_config_warning(
+      "Warning: Ignoring lame host dependency of '"
+      + dependend_host_name + "' on host/hostgroups '"
+      + host_name + "'.");
   }
 
   return ;
@@ -239,11 +236,10 @@ void hostdependency::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool hostdependency::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (false);
 }
 
@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/configuration/hostextinfo.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -175,11 +176,10 @@ void hostextinfo::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool hostextinfo::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (false);
 }
 
@@ -32,13 +32,27 @@
 #include "com/centreon/engine/configuration/serviceextinfo.hh"
 #include "com/centreon/engine/configuration/servicegroup.hh"
 #include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/configuration/timeperiod.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine::configuration;
 
+extern int config_warnings;
+
+// Objects are parsed and checked concurrently, protect the warning
+// counter.
+static concurrency::mutex _config_warnings_lock;
+
+// If not NULL, warnings of the current thread are stored here instead
+// of being logged.
+static __thread std::vector<std::string>* _config_warnings_buffer(NULL);
+
 #define SETTER(type, method) \
   &object::setter<object, type, &object::method>::generic
 
@@ -114,6 +128,19 @@ bool object::operator!=(object const& right) const throw () {
   return (!operator==(right));
 }
 
+/**
+ *  Store the configuration warnings of the current thread instead of
+ *  logging them, so that they can be logged in definition order once
+ *  objects were parsed concurrently.
+ *
+ *  @param[out] warnings  Where warnings are stored, NULL to log them
+ *                        again.
+ */
+void object::buffer_config_warnings(std::vector<std::string>* warnings) {
+  _config_warnings_buffer = warnings;
+  return ;
+}
+
 /**
  *  Create object with object type.
  *
@@ -156,6 +183,20 @@ object_ptr object::create(std::string const& type_name) {
   return (obj);
 }
 
+/**
+ *  Log and count stored configuration warnings.
+ *
+ *  @param[in] warnings  Warnings stored by buffer_config_warnings().
+ */
+void object::log_config_warnings(std::vector<std::string> const& warnings) {
+  for (std::vector<std::string>::const_iterator
+         it(warnings.begin()), end(warnings.end());
+       it != end;
+       ++it)
+    _add_config_warning(*it);
+  return ;
+}
+
 /**
  *  Get the object name.
  *
@@ -174,11 +215,10 @@ std::string const& object::name() const throw () {
  *  @return True on success, otherwise false.
  */
 bool object::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (false);
 }
 
@@ -272,6 +312,26 @@ std::string const& object::type_name() const throw () {
   return (tab[_type]);
 }
 
+/**
+ *  Log and count a configuration warning, or store it if warnings of
+ *  the current thread are buffered. Setters and validity checks can
+ *  run in parser threads.
+ *
+ *  @param[in] message  Warning message.
+ */
+void object::_add_config_warning(std::string const& message) {
+  if (_config_warnings_buffer) {
+    _config_warnings_buffer->push_back(message);
+    return ;
+  }
+  {
+    concurrency::locker lock(&_config_warnings_lock);
+    ++config_warnings;
+  }
+  logger(logging::log_config_warning, logging::basic) << message;
+  return ;
+}
+
 /**
  *  Set name value.
  *
@@ -17,8 +17,11 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <unistd.h>
+#include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/io/directory_entry.hh"
 
@@ -52,6 +55,9 @@ parser::store parser::_store[] = {
  */
 parser::parser(unsigned int read_options)
   : _config(NULL),
+    _job(NULL),
+    _job_count(0),
+    _next_job(0),
     _read_options(read_options) {}
 
 /**
@@ -71,12 +77,35 @@ void parser::parse(std::string const& path, state& config) {
   // parse the global configuration file.
   _parse_global_configuration(path);
 
-  // parse configuration files.
-  _apply(config.cfg_file(), &parser::_parse_object_definitions);
-  // parse resource files.
+  // list object definition files, configuration files first and then
+  // the files of configuration directories.
+  std::list<std::string> const& cfg_files(config.cfg_file());
+  for (std::list<std::string>::const_iterator
+         it(cfg_files.begin()), end(cfg_files.end());
+       it != end;
+       ++it) {
+    _files.push_back(object_file());
+    _files.back().path = *it;
+  }
+  std::size_t dir_files(_files.size());
+  std::list<std::string> const& cfg_dirs(config.cfg_dir());
+  for (std::list<std::string>::const_iterator
+         it(cfg_dirs.begin()), end(cfg_dirs.end());
+       it != end;
+       ++it)
+    _list_directory_configuration(*it, _files);
+
+  // parse object definition files concurrently.
+  _run_jobs(&parser::_parse_object_file, _files.size());
+
+  // merge configuration files, parse resource files and merge
+  // configuration directories, in the order of sequential parsing.
+  for (std::size_t i(0); i < dir_files; ++i)
+    _merge_object_file(_files[i]);
   _apply(config.resource_file(), &parser::_parse_resource_file);
-  // parse configuration directories.
-  _apply(config.cfg_dir(), &parser::_parse_directory_configuration);
+  for (std::size_t i(dir_files); i < _files.size(); ++i)
+    _merge_object_file(_files[i]);
+  _files.clear();
 
   // Apply template.
   _resolve_template();
@@ -111,6 +140,27 @@ void parser::parse(std::string const& path, state& config) {
   }
 }
 
+/**
+ *  Constructor.
+ *
+ *  @param[in] owner  Parser whose jobs are run.
+ */
+parser::worker::worker(parser& owner)
+  : _owner(owner) {}
+
+/**
+ *  Destructor.
+ */
+parser::worker::~worker() throw () {}
+
+/**
+ *  Thread entry point.
+ */
+void parser::worker::_run() {
+  _owner._run_pending_jobs();
+  return ;
+}
+
 /**
  *  Add object into the list.
  *
@@ -354,6 +404,36 @@ void parser::_insert(
   return ;
 }
 
+/**
+ *  List the object definition files of a configuration directory.
+ *
+ *  @param[in]     path   The directory path.
+ *  @param[in,out] files  Object definition files, new files are
+ *                        appended.
+ */
+void parser::_list_directory_configuration(
+       std::string const& path,
+       std::vector<object_file>& files) {
+  try {
+    directory_entry dir(path);
+    std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
+    for (std::list<file_entry>::const_iterator
+           it(lst.begin()), end(lst.end());
+         it != end;
+         ++it) {
+      files.push_back(object_file());
+      files.back().path = it->path();
+    }
+  }
+  catch (std::exception const& e) {
+    // Reported when merging, like a parsing error. Without path, no
+    // file is logged as being processed.
+    files.push_back(object_file());
+    files.back().error = e.what();
+  }
+  return ;
+}
+
 /**
  *  Get the map object type name.
  *
@@ -371,18 +451,34 @@ std::string const& parser::_map_object_type(
 }
 
 /**
- *  Parse the directory configuration.
+ *  Add the objects of a parsed object definition file.
  *
- *  @param[in] path The directory path.
+ *  @param[in] file  Parsed object definition file.
  */
-void parser::_parse_directory_configuration(std::string const& path) {
-  directory_entry dir(path);
-  std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
-  for (std::list<file_entry>::const_iterator
-         it(lst.begin()), end(lst.end());
+void parser::_merge_object_file(object_file const& file) {
+  if (!file.path.empty())
+    logger(logging::log_info_message, logging::basic)
+      << "Processing object config file '" << file.path << "'";
+  object::log_config_warnings(file.warnings);
+
+  for (std::vector<std::pair<object_ptr, unsigned int> >::const_iterator
+         it(file.objects.begin()), end(file.objects.end());
        it != end;
-       ++it)
-    _parse_object_definitions(it->path());
+       ++it) {
+    object_ptr const& obj(it->first);
+    _objects_info[obj.get()] = file_info(file.path, it->second);
+    if (!obj->name().empty())
+      _add_template(obj);
+    if (obj->should_register())
+      _add_object(obj);
+  }
+
+  // Objects defined before the error were added, so that duplicates
+  // are reported first, like with sequential parsing. The message
+  // already has the debugging informations of the original error.
+  if (!file.error.empty())
+    throw (error() << file.error);
+  return ;
 }
 
 /**
@@ -417,78 +513,97 @@ void parser::_parse_global_configuration(std::string const& path) {
 }
 
 /**
- *  Parse the object definition file.
+ *  Parse the object definition file. Errors are stored in the file,
+ *  this method can be run by several threads.
  *
- *  @param[in] path The object definitions path.
+ *  @param[in,out] file          The object definition file.
+ *  @param[in]     read_options  Configuration file reading options.
  */
-void parser::_parse_object_definitions(std::string const& path) {
-  logger(logging::log_info_message, logging::basic)
-    << "Processing object config file '" << path << "'";
-
-  std::ifstream stream(path.c_str(), std::ios::binary);
-  if (!stream.is_open())
-    throw (engine_error() << "Parsing of object definition failed: "
-           << "Can't open file '" << path << "'");
-
-  _current_line = 0;
-  _current_path = path;
-
-  bool parse_object(false);
-  object_ptr obj;
-  std::string input;
-  while (string::get_next_line(stream, input, _current_line)) {
-    // Multi-line.
-    while ('\\' == input[input.size() - 1]) {
-      input.resize(input.size() - 1);
-      std::string addendum;
-      if (!string::get_next_line(stream, addendum, _current_line))
-        break ;
-      input.append(addendum);
-    }
+void parser::_parse_object_definitions(
+       object_file& file,
+       unsigned int read_options) {
+  try {
+    std::ifstream stream(file.path.c_str(), std::ios::binary);
+    if (!stream.is_open())
+      throw (engine_error() << "Parsing of object definition failed: "
+             << "Can't open file '" << file.path << "'");
+
+    unsigned int current_line(0);
+    unsigned int object_line(0);
+    bool parse_object(false);
+    object_ptr obj;
+    std::string input;
+    while (string::get_next_line(stream, input, current_line)) {
+      // Multi-line.
+      while ('\\' == input[input.size() - 1]) {
+        input.resize(input.size() - 1);
+        std::string addendum;
+        if (!string::get_next_line(stream, addendum, current_line))
+          break ;
+        input.append(addendum);
+      }
 
-    // Check if is a valid object.
-    if (obj.is_null()) {
-      if (input.find("define") || !std::isspace(input[6]))
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unexpected start definition");
-      string::trim_left(input.erase(0, 6));
-      std::size_t last(input.size() - 1);
-      if (input.empty() || input[last] != '{')
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unexpected start definition");
-      std::string const& type(string::trim_right(input.erase(last)));
-      obj = object::create(type);
-      if (obj.is_null())
-        throw (engine_error() << "Parsing of object definition failed "
-               << "in file '" << _current_path << "' on line "
-               << _current_line << ": Unknown object type name '"
-               << type << "'");
-      parse_object = (_read_options & (1 << obj->type()));
-      _objects_info[obj.get()] = file_info(path, _current_line);
-    }
-    // Check if is the not the end of the current object.
-    else if (input != "}") {
-      if (parse_object) {
-        if (!obj->parse(input))
-          throw (engine_error() << "Parsing of object definition "
-                 << "failed in file '" << _current_path << "' on line "
-                 << _current_line << ": Invalid line '"
-                 << input << "'");
+      // Check if is a valid object.
+      if (obj.is_null()) {
+        if (input.find("define") || !std::isspace(input[6]))
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unexpected start definition");
+        string::trim_left(input.erase(0, 6));
+        std::size_t last(input.size() - 1);
+        if (input.empty() || input[last] != '{')
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unexpected start definition");
+        std::string const& type(string::trim_right(input.erase(last)));
+        obj = object::create(type);
+        if (obj.is_null())
+          throw (engine_error() << "Parsing of object definition failed "
+                 << "in file '" << file.path << "' on line "
+                 << current_line << ": Unknown object type name '"
+                 << type << "'");
+        parse_object = (read_options & (1 << obj->type()));
+        object_line = current_line;
       }
-    }
-    // End of the current object.
-    else {
-      if (parse_object) {
-        if (!obj->name().empty())
-          _add_template(obj);
-        if (obj->should_register())
-          _add_object(obj);
+      // Check if is the not the end of the current object.
+      else if (input != "}") {
+        if (parse_object) {
+          if (!obj->parse(input))
+            throw (engine_error() << "Parsing of object definition "
+                   << "failed in file '" << file.path << "' on line "
+                   << current_line << ": Invalid line '"
+                   << input << "'");
+        }
+      }
+      // End of the current object.
+      else {
+        if (parse_object)
+          file.objects.push_back(std::make_pair(obj, object_line));
+        obj.clear();
       }
-      obj.clear();
     }
   }
+  catch (std::exception const& e) {
+    file.error = e.what();
+  }
+  return ;
+}
+
+/**
+ *  Parse an object definition file.
+ *
+ *  @param[in] index  Index of the file.
+ */
+void parser::_parse_object_file(std::size_t index) {
+  object_file& file(_files[index]);
+  if (file.path.empty())
+    return ;
+
+  // Warnings are logged when the file is merged, in file order.
+  object::buffer_config_warnings(&file.warnings);
+  _parse_object_definitions(file, _read_options);
+  object::buffer_config_warnings(NULL);
+  return ;
 }
 
 /**
@@ -528,10 +643,39 @@ void parser::_parse_resource_file(std::string const& path) {
   }
 }
 
+/**
+ *  Resolve the templates of an object and check its validity. Errors
+ *  are stored, this method can be run by several threads.
+ *
+ *  @param[in] index  Index of the object.
+ */
+void parser::_resolve_object(std::size_t index) {
+  object_resolution& resolution(_resolutions[index]);
+  object* obj(resolution.obj);
+  object::buffer_config_warnings(&resolution.warnings);
+  try {
+    obj->resolve_template(_templates[obj->type()]);
+    try {
+      obj->check_validity();
+    }
+    catch (std::exception const& e) {
+      throw (engine_error() << "Configuration parsing failed "
+             << _get_file_info(obj) << ": " << e.what());
+    }
+  }
+  catch (std::exception const& e) {
+    resolution.error = e.what();
+  }
+  object::buffer_config_warnings(NULL);
+  return ;
+}
+
 /**
  *  Resolve template for register objects.
  */
 void parser::_resolve_template() {
+  // Templates are resolved first, once for all. Objects only merge
+  // their already resolved parents, and are then independent.
   for (unsigned int i(0);
        i < sizeof(_templates) / sizeof(_templates[0]);
        ++i) {
@@ -545,41 +689,101 @@ void parser::_resolve_template() {
 
   for (unsigned int i(0);
        i < sizeof(_lst_objects) / sizeof(_lst_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
+       ++i)
     for (list_object::iterator
            it(_lst_objects[i].begin()), end(_lst_objects[i].end());
          it != end;
-         ++it) {
-      (*it)->resolve_template(templates);
-      try {
-        (*it)->check_validity();
-      }
-      catch (std::exception const& e) {
-        throw (engine_error() << "Configuration parsing failed "
-               << _get_file_info(it->get()) << ": " << e.what());
-      }
-    }
-  }
-
+         ++it)
+      _resolutions.push_back(object_resolution(it->get()));
   for (unsigned int i(0);
        i < sizeof(_map_objects) / sizeof(_map_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
+       ++i)
     for (map_object::iterator
            it(_map_objects[i].begin()), end(_map_objects[i].end());
          it != end;
-         ++it) {
-      it->second->resolve_template(templates);
-      try {
-        it->second->check_validity();
-      }
-      catch (std::exception const& e) {
-        throw (engine_error() << "Configuration parsing failed "
-               << _get_file_info(it->second.get()) << ": " << e.what());
-      }
+         ++it)
+      _resolutions.push_back(object_resolution(it->second.get()));
+
+  _run_jobs(&parser::_resolve_object, _resolutions.size());
+
+  // Report warnings up to the first error, like with sequential
+  // resolution.
+  for (std::vector<object_resolution>::const_iterator
+         it(_resolutions.begin()), end(_resolutions.end());
+       it != end;
+       ++it) {
+    object::log_config_warnings(it->warnings);
+    if (!it->error.empty()) {
+      std::string message(it->error);
+      _resolutions.clear();
+      throw (error() << message);
+    }
+  }
+  _resolutions.clear();
+  return ;
+}
+
+/**
+ *  Run jobs, with the current thread and workers, until all of them
+ *  are run.
+ *
+ *  @param[in] j      Job.
+ *  @param[in] count  Number of jobs, indexed from 0 to count - 1.
+ */
+void parser::_run_jobs(job j, std::size_t count) {
+  _job = j;
+  _job_count = count;
+  _next_job = 0;
+
+  long cpus(sysconf(_SC_NPROCESSORS_ONLN));
+  std::size_t threads(cpus > 0 ? cpus : 1);
+  if (threads > count)
+    threads = count;
+
+  std::vector<worker*> workers;
+  for (std::size_t i(1); i < threads; ++i) {
+    worker* w(new worker(*this));
+    try {
+      w->exec();
+    }
+    catch (std::exception const& e) {
+      // Run jobs with the workers already started.
+      logger(logging::log_runtime_warning, logging::basic)
+        << "Warning: Could not start configuration parser thread: "
+        << e.what();
+      delete w;
+      break ;
     }
+    workers.push_back(w);
+  }
+
+  _run_pending_jobs();
+
+  for (std::vector<worker*>::iterator
+         it(workers.begin()), end(workers.end());
+       it != end;
+       ++it) {
+    (*it)->wait();
+    delete *it;
   }
+  return ;
+}
+
+/**
+ *  Run the jobs not taken by another thread.
+ */
+void parser::_run_pending_jobs() {
+  for (;;) {
+    std::size_t index;
+    {
+      concurrency::locker lock(&_jobs_lock);
+      if (_next_job >= _job_count)
+        break ;
+      index = _next_job++;
+    }
+    (this->*_job)(index);
+  }
+  return ;
 }
 
 /**
@@ -19,17 +19,15 @@
 
 #include "com/centreon/engine/configuration/service.hh"
 #include "com/centreon/engine/configuration/serviceextinfo.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
-#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
-using namespace com::centreon::engine::logging;
 
 #define SETTER(type, method) \
   &object::setter<service, type, &service::method>::generic
@@ -527,11 +525,10 @@ void service::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool service::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   if (key[0] == '_') {
     _customvariables[key + 1] = value;
     return (true);
@@ -1266,9 +1263,8 @@ bool service::_set_event_handler_enabled(bool value) {
  */
 bool service::_set_failure_prediction_enabled(bool value) {
   (void)value;
-  logger(log_config_warning, basic)
-    << "Warning: service failure_prediction_enabled was ignored";
-  ++config_warnings;
+  _add_config_warning(
+    "Warning: service failure_prediction_enabled was ignored");
   return (true);
 }
 
@@ -1281,9 +1277,8 @@ bool service::_set_failure_prediction_enabled(bool value) {
  */
 bool service::_set_failure_prediction_options(std::string const& value) {
   (void)value;
-  logger(log_config_warning, basic)
-    << "Warning: service failure_prediction_options was ignored";
-  ++config_warnings;
+  _add_config_warning(
+    "Warning: service failure_prediction_options was ignored");
   return (true);
 }
 
@@ -1599,9 +1594,8 @@ bool service::_set_obsess_over_service(bool value) {
  */
 bool service::_set_parallelize_check(bool value) {
   (void)value;
-  logger(log_config_warning, basic)
-    << "Warning: service parallelize_check was ignored";
-  ++config_warnings;
+  _add_config_warning(
+    "Warning: service parallelize_check was ignored");
   return (true);
 }
 
@@ -18,16 +18,14 @@
 */
 
 #include "com/centreon/engine/configuration/servicedependency.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
-#include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
 using namespace com::centreon::engine::configuration;
-using namespace com::centreon::engine::logging;
 
 #define SETTER(type, method) \
   &object::setter<servicedependency, type, &servicedependency::method>::generic
@@ -233,7 +231,6 @@ void servicedependency::check_validity() const {
 
   // With no execution or failure options this dependency is useless.
   if (!_execution_failure_options && !_notification_failure_options) {
-    ++config_warnings;
     std::ostringstream msg;
     msg << "Warning: Ignoring lame service dependency of ";
     if (!_dependent_servicegroups->empty())
@@ -256,7 +253,7 @@ void servicedependency::check_validity() const {
       else
         msg << "host '" << _hosts->front() << "'";
     }
-    logger(log_config_warning, basic) << msg.str();
+    _add_config_warning(msg.str());
   }
 
   return ;
@@ -305,11 +302,10 @@ void servicedependency::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool servicedependency::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (false);
 }
 
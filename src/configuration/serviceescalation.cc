@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/configuration/serviceescalation.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -229,11 +230,10 @@ void serviceescalation::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool serviceescalation::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (false);
 }
 
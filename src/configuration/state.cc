@@ -20,6 +20,7 @@
 #include <limits>
 #include "compatibility/locations.h"
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/globals.hh"
@@ -124,7 +125,9 @@ state::setters const state::_setters[] = {
   { "max_service_check_spread",                    SETTER(unsigned int, max_service_check_spread) },
   { "nagios_group",                                SETTER(std::string const&, _set_nagios_group) },
   { "nagios_user",                                 SETTER(std::string const&, _set_nagios_user) },
+  { "notification_queue_size",                     SETTER(unsigned int, notification_queue_size) },
   { "notification_timeout",                        SETTER(unsigned int, notification_timeout) },
+  { "notification_workers",                        SETTER(unsigned int, notification_workers) },
   { "object_cache_file",                           SETTER(std::string const&, _set_object_cache_file) },
   { "obsess_over_hosts",                           SETTER(bool, obsess_over_hosts) },
   { "obsess_over_services",                        SETTER(bool, obsess_over_services) },
@@ -250,7 +253,9 @@ static unsigned int const              default_max_host_check_spread(5);
 static unsigned long const             default_max_log_file_size(0);
 static unsigned int const              default_max_parallel_service_checks(0);
 static unsigned int const              default_max_service_check_spread(5);
+static unsigned int const              default_notification_queue_size(4096);
 static unsigned int const              default_notification_timeout(30);
+static unsigned int const              default_notification_workers(0);
 static bool const                      default_obsess_over_hosts(false);
 static bool const                      default_obsess_over_services(false);
 static std::string const               default_ochp_command("");
@@ -362,7 +367,9 @@ state::state()
     _max_log_file_size(default_max_log_file_size),
     _max_parallel_service_checks(default_max_parallel_service_checks),
     _max_service_check_spread(default_max_service_check_spread),
+    _notification_queue_size(default_notification_queue_size),
     _notification_timeout(default_notification_timeout),
+    _notification_workers(default_notification_workers),
     _obsess_over_hosts(default_obsess_over_hosts),
     _obsess_over_services(default_obsess_over_services),
     _ochp_command(default_ochp_command),
@@ -505,7 +512,9 @@ state& state::operator=(state const& right) {
     _max_log_file_size = right._max_log_file_size;
     _max_parallel_service_checks = right._max_parallel_service_checks;
     _max_service_check_spread = right._max_service_check_spread;
+    _notification_queue_size = right._notification_queue_size;
     _notification_timeout = right._notification_timeout;
+    _notification_workers = right._notification_workers;
     _obsess_over_hosts = right._obsess_over_hosts;
     _obsess_over_services = right._obsess_over_services;
     _ochp_command = right._ochp_command;
@@ -567,134 +576,20 @@ state& state::operator=(state const& right) {
  *  @return True if object is the same object, otherwise false.
  */
 bool state::operator==(state const& right) const throw () {
-  return (_accept_passive_host_checks == right._accept_passive_host_checks
-          && _accept_passive_service_checks == right._accept_passive_service_checks
-          && _additional_freshness_latency == right._additional_freshness_latency
-          && _admin_email == right._admin_email
-          && _admin_pager == right._admin_pager
-          && _allow_empty_hostgroup_assignment == right._allow_empty_hostgroup_assignment
-          && _auto_reschedule_checks == right._auto_reschedule_checks
-          && _auto_rescheduling_interval == right._auto_rescheduling_interval
-          && _auto_rescheduling_window == right._auto_rescheduling_window
-          && _broker_module_directory == right._broker_module_directory
-          && _cached_host_check_horizon == right._cached_host_check_horizon
-          && _cached_service_check_horizon == right._cached_service_check_horizon
-          && _check_external_commands == right._check_external_commands
-          && _check_host_freshness == right._check_host_freshness
-          && _check_orphaned_hosts == right._check_orphaned_hosts
-          && _check_orphaned_services == right._check_orphaned_services
-          && _check_reaper_interval == right._check_reaper_interval
-          && _check_result_path == right._check_result_path
-          && _check_service_freshness == right._check_service_freshness
+  return (globals_equal(right)
           && _commands == right._commands
-          && _command_check_interval == right._command_check_interval
-          && _command_check_interval_is_seconds == right._command_check_interval_is_seconds
-          && _command_file == right._command_file
           && _connectors == right._connectors
           && _contactgroups == right._contactgroups
           && _contacts == right._contacts
-          && _date_format == right._date_format
-          && _debug_file == right._debug_file
-          && _debug_level == right._debug_level
-          && _debug_verbosity == right._debug_verbosity
-          && _enable_environment_macros == right._enable_environment_macros
-          && _enable_event_handlers == right._enable_event_handlers
-          && _enable_flap_detection == right._enable_flap_detection
-          && _enable_notifications == right._enable_notifications
-          && _enable_predictive_host_dependency_checks == right._enable_predictive_host_dependency_checks
-          && _enable_predictive_service_dependency_checks == right._enable_predictive_service_dependency_checks
-          && _event_broker_options == right._event_broker_options
-          && _event_handler_timeout == right._event_handler_timeout
-          && _execute_host_checks == right._execute_host_checks
-          && _execute_service_checks == right._execute_service_checks
-          && _external_command_buffer_slots == right._external_command_buffer_slots
-          && _global_host_event_handler == right._global_host_event_handler
-          && _global_service_event_handler == right._global_service_event_handler
-          && _high_host_flap_threshold == right._high_host_flap_threshold
-          && _high_service_flap_threshold == right._high_service_flap_threshold
           && _hostdependencies == right._hostdependencies
           && _hostescalations == right._hostescalations
           && _hostgroups == right._hostgroups
           && _hosts == right._hosts
-          && _host_check_timeout == right._host_check_timeout
-          && _host_freshness_check_interval == right._host_freshness_check_interval
-          && _host_inter_check_delay_method == right._host_inter_check_delay_method
-          && _host_perfdata_command == right._host_perfdata_command
-          && _host_perfdata_file == right._host_perfdata_file
-          && _host_perfdata_file_mode == right._host_perfdata_file_mode
-          && _host_perfdata_file_processing_command == right._host_perfdata_file_processing_command
-          && _host_perfdata_file_processing_interval == right._host_perfdata_file_processing_interval
-          && _host_perfdata_file_template == right._host_perfdata_file_template
-          && _illegal_object_chars == right._illegal_object_chars
-          && _illegal_output_chars == right._illegal_output_chars
-          && _interval_length == right._interval_length
-          && _log_event_handlers == right._log_event_handlers
-          && _log_external_commands == right._log_external_commands
-          && _log_file == right._log_file
-          && _log_host_retries == right._log_host_retries
-          && _log_notifications == right._log_notifications
-          && _log_passive_checks == right._log_passive_checks
-          && _log_pid == right._log_pid
-          && _log_service_retries == right._log_service_retries
-          && _low_host_flap_threshold == right._low_host_flap_threshold
-          && _low_service_flap_threshold == right._low_service_flap_threshold
-          && _max_check_reaper_time == right._max_check_reaper_time
-          && _max_check_result_file_age == right._max_check_result_file_age
-          && _max_debug_file_size == right._max_debug_file_size
-          && _max_host_check_spread == right._max_host_check_spread
-          && _max_log_file_size == right._max_log_file_size
-          && _max_parallel_service_checks == right._max_parallel_service_checks
-          && _max_service_check_spread == right._max_service_check_spread
-          && _notification_timeout == right._notification_timeout
-          && _obsess_over_hosts == right._obsess_over_hosts
-          && _obsess_over_services == right._obsess_over_services
-          && _ochp_command == right._ochp_command
-          && _ochp_timeout == right._ochp_timeout
-          && _ocsp_command == right._ocsp_command
-          && _ocsp_timeout == right._ocsp_timeout
-          && _passive_host_checks_are_soft == right._passive_host_checks_are_soft
-          && _perfdata_timeout == right._perfdata_timeout
-          && _process_performance_data == right._process_performance_data
-          && _retained_contact_host_attribute_mask == right._retained_contact_host_attribute_mask
-          && _retained_contact_service_attribute_mask == right._retained_contact_service_attribute_mask
-          && _retained_host_attribute_mask == right._retained_host_attribute_mask
-          && _retained_process_host_attribute_mask == right._retained_process_host_attribute_mask
-          && _retain_state_information == right._retain_state_information
-          && _retention_scheduling_horizon == right._retention_scheduling_horizon
-          && _retention_update_interval == right._retention_update_interval
           && _servicedependencies == right._servicedependencies
           && _serviceescalations == right._serviceescalations
           && _servicegroups == right._servicegroups
           && _services == right._services
-          && _service_check_timeout == right._service_check_timeout
-          && _service_freshness_check_interval == right._service_freshness_check_interval
-          && _service_inter_check_delay_method == right._service_inter_check_delay_method
-          && _service_interleave_factor_method == right._service_interleave_factor_method
-          && _service_perfdata_command == right._service_perfdata_command
-          && _service_perfdata_file == right._service_perfdata_file
-          && _service_perfdata_file_mode == right._service_perfdata_file_mode
-          && _service_perfdata_file_processing_command == right._service_perfdata_file_processing_command
-          && _service_perfdata_file_processing_interval == right._service_perfdata_file_processing_interval
-          && _service_perfdata_file_template == right._service_perfdata_file_template
-          && _sleep_time == right._sleep_time
-          && _soft_state_dependencies == right._soft_state_dependencies
-          && _state_retention_file == right._state_retention_file
-          && _status_file == right._status_file
-          && _status_update_interval == right._status_update_interval
-          && _timeperiods == right._timeperiods
-          && _time_change_threshold == right._time_change_threshold
-          && _translate_passive_host_checks == right._translate_passive_host_checks
-          && _users == right._users
-          && _use_aggressive_host_checking == right._use_aggressive_host_checking
-          && _use_check_result_path == right._use_check_result_path
-          && _use_large_installation_tweaks == right._use_large_installation_tweaks
-          && _use_regexp_matches == right._use_regexp_matches
-          && _use_retained_program_state == right._use_retained_program_state
-          && _use_retained_scheduling_info == right._use_retained_scheduling_info
-          && _use_setpgid == right._use_setpgid
-          && _use_syslog == right._use_syslog
-          && _use_timezone == right._use_timezone
-          && _use_true_regexp_matching == right._use_true_regexp_matching);
+          && _timeperiods == right._timeperiods);
 }
 
 /**
@@ -1744,6 +1639,136 @@ void state::global_service_event_handler(std::string const& value) {
 
 }
 
+/**
+ *  Compare the global options of two configurations, without their
+ *  objects.
+ *
+ *  @param[in] right The object to compare.
+ *
+ *  @return True if global options are the same, otherwise false.
+ */
+bool state::globals_equal(state const& right) const throw () {
+  return (_accept_passive_host_checks == right._accept_passive_host_checks
+          && _accept_passive_service_checks == right._accept_passive_service_checks
+          && _additional_freshness_latency == right._additional_freshness_latency
+          && _admin_email == right._admin_email
+          && _admin_pager == right._admin_pager
+          && _allow_empty_hostgroup_assignment == right._allow_empty_hostgroup_assignment
+          && _auto_reschedule_checks == right._auto_reschedule_checks
+          && _auto_rescheduling_interval == right._auto_rescheduling_interval
+          && _auto_rescheduling_window == right._auto_rescheduling_window
+          && _broker_module == right._broker_module
+          && _broker_module_directory == right._broker_module_directory
+          && _cached_host_check_horizon == right._cached_host_check_horizon
+          && _cached_service_check_horizon == right._cached_service_check_horizon
+          && _check_external_commands == right._check_external_commands
+          && _check_host_freshness == right._check_host_freshness
+          && _check_orphaned_hosts == right._check_orphaned_hosts
+          && _check_orphaned_services == right._check_orphaned_services
+          && _check_reaper_interval == right._check_reaper_interval
+          && _check_result_path == right._check_result_path
+          && _check_service_freshness == right._check_service_freshness
+          && _command_check_interval == right._command_check_interval
+          && _command_check_interval_is_seconds == right._command_check_interval_is_seconds
+          && _command_file == right._command_file
+          && _date_format == right._date_format
+          && _debug_file == right._debug_file
+          && _debug_level == right._debug_level
+          && _debug_verbosity == right._debug_verbosity
+          && _enable_environment_macros == right._enable_environment_macros
+          && _enable_event_handlers == right._enable_event_handlers
+          && _enable_flap_detection == right._enable_flap_detection
+          && _enable_notifications == right._enable_notifications
+          && _enable_predictive_host_dependency_checks == right._enable_predictive_host_dependency_checks
+          && _enable_predictive_service_dependency_checks == right._enable_predictive_service_dependency_checks
+          && _event_broker_options == right._event_broker_options
+          && _event_handler_timeout == right._event_handler_timeout
+          && _execute_host_checks == right._execute_host_checks
+          && _execute_service_checks == right._execute_service_checks
+          && _external_command_buffer_slots == right._external_command_buffer_slots
+          && _global_host_event_handler == right._global_host_event_handler
+          && _global_service_event_handler == right._global_service_event_handler
+          && _high_host_flap_threshold == right._high_host_flap_threshold
+          && _high_service_flap_threshold == right._high_service_flap_threshold
+          && _host_check_timeout == right._host_check_timeout
+          && _host_freshness_check_interval == right._host_freshness_check_interval
+          && _host_inter_check_delay_method == right._host_inter_check_delay_method
+          && _host_perfdata_command == right._host_perfdata_command
+          && _host_perfdata_file == right._host_perfdata_file
+          && _host_perfdata_file_mode == right._host_perfdata_file_mode
+          && _host_perfdata_file_processing_command == right._host_perfdata_file_processing_command
+          && _host_perfdata_file_processing_interval == right._host_perfdata_file_processing_interval
+          && _host_perfdata_file_template == right._host_perfdata_file_template
+          && _illegal_object_chars == right._illegal_object_chars
+          && _illegal_output_chars == right._illegal_output_chars
+          && _interval_length == right._interval_length
+          && _log_event_handlers == right._log_event_handlers
+          && _log_external_commands == right._log_external_commands
+          && _log_file == right._log_file
+          && _log_host_retries == right._log_host_retries
+          && _log_notifications == right._log_notifications
+          && _log_passive_checks == right._log_passive_checks
+          && _log_pid == right._log_pid
+          && _log_service_retries == right._log_service_retries
+          && _low_host_flap_threshold == right._low_host_flap_threshold
+          && _low_service_flap_threshold == right._low_service_flap_threshold
+          && _max_check_reaper_time == right._max_check_reaper_time
+          && _max_check_result_file_age == right._max_check_result_file_age
+          && _max_debug_file_size == right._max_debug_file_size
+          && _max_host_check_spread == right._max_host_check_spread
+          && _max_log_file_size == right._max_log_file_size
+          && _max_parallel_service_checks == right._max_parallel_service_checks
+          && _max_service_check_spread == right._max_service_check_spread
+          && _notification_queue_size == right._notification_queue_size
+          && _notification_timeout == right._notification_timeout
+          && _notification_workers == right._notification_workers
+          && _obsess_over_hosts == right._obsess_over_hosts
+          && _obsess_over_services == right._obsess_over_services
+          && _ochp_command == right._ochp_command
+          && _ochp_timeout == right._ochp_timeout
+          && _ocsp_command == right._ocsp_command
+          && _ocsp_timeout == right._ocsp_timeout
+          && _passive_host_checks_are_soft == right._passive_host_checks_are_soft
+          && _perfdata_timeout == right._perfdata_timeout
+          && _process_performance_data == right._process_performance_data
+          && _resource_file == right._resource_file
+          && _retained_contact_host_attribute_mask == right._retained_contact_host_attribute_mask
+          && _retained_contact_service_attribute_mask == right._retained_contact_service_attribute_mask
+          && _retained_host_attribute_mask == right._retained_host_attribute_mask
+          && _retained_process_host_attribute_mask == right._retained_process_host_attribute_mask
+          && _retain_state_information == right._retain_state_information
+          && _retention_scheduling_horizon == right._retention_scheduling_horizon
+          && _retention_update_interval == right._retention_update_interval
+          && _service_check_timeout == right._service_check_timeout
+          && _service_freshness_check_interval == right._service_freshness_check_interval
+          && _service_inter_check_delay_method == right._service_inter_check_delay_method
+          && _service_interleave_factor_method == right._service_interleave_factor_method
+          && _service_perfdata_command == right._service_perfdata_command
+          && _service_perfdata_file == right._service_perfdata_file
+          && _service_perfdata_file_mode == right._service_perfdata_file_mode
+          && _service_perfdata_file_processing_command == right._service_perfdata_file_processing_command
+          && _service_perfdata_file_processing_interval == right._service_perfdata_file_processing_interval
+          && _service_perfdata_file_template == right._service_perfdata_file_template
+          && _sleep_time == right._sleep_time
+          && _soft_state_dependencies == right._soft_state_dependencies
+          && _state_retention_file == right._state_retention_file
+          && _status_file == right._status_file
+          && _status_update_interval == right._status_update_interval
+          && _time_change_threshold == right._time_change_threshold
+          && _translate_passive_host_checks == right._translate_passive_host_checks
+          && _users == right._users
+          && _use_aggressive_host_checking == right._use_aggressive_host_checking
+          && _use_check_result_path == right._use_check_result_path
+          && _use_large_installation_tweaks == right._use_large_installation_tweaks
+          && _use_regexp_matches == right._use_regexp_matches
+          && _use_retained_program_state == right._use_retained_program_state
+          && _use_retained_scheduling_info == right._use_retained_scheduling_info
+          && _use_setpgid == right._use_setpgid
+          && _use_syslog == right._use_syslog
+          && _use_timezone == right._use_timezone
+          && _use_true_regexp_matching == right._use_true_regexp_matching);
+}
+
 /**
  *  Get high_host_flap_threshold value.
  *
@@ -2485,6 +2510,26 @@ void state::max_service_check_spread(unsigned int value) {
   _max_service_check_spread = value;
 }
 
+/**
+ *  Get notification_queue_size value.
+ *
+ *  @return The notification_queue_size value.
+ */
+unsigned int state::notification_queue_size() const throw () {
+  return (_notification_queue_size);
+}
+
+/**
+ *  Set notification_queue_size value.
+ *
+ *  @param[in] value The new notification_queue_size value.
+ */
+void state::notification_queue_size(unsigned int value) {
+  if (!value)
+    throw (engine_error() << "notification_queue_size cannot be 0");
+  _notification_queue_size = value;
+}
+
 /**
  *  Get notification_timeout value.
  *
@@ -2505,6 +2550,24 @@ void state::notification_timeout(unsigned int value) {
   _notification_timeout = value;
 }
 
+/**
+ *  Get notification_workers value.
+ *
+ *  @return The notification_workers value.
+ */
+unsigned int state::notification_workers() const throw () {
+  return (_notification_workers);
+}
+
+/**
+ *  Set notification_workers value.
+ *
+ *  @param[in] value The new notification_workers value.
+ */
+void state::notification_workers(unsigned int value) {
+  _notification_workers = value;
+}
+
 /**
  *  Get obsess_over_hosts value.
  *
@@ -3285,11 +3348,10 @@ void state::status_update_interval(unsigned int value) {
  */
 bool state::set(char const* key, char const* value) {
   try {
-    for (unsigned int i(0);
-         i < sizeof(_setters) / sizeof(_setters[0]);
-         ++i)
-      if (!strcmp(_setters[i].name, key))
-        return ((_setters[i].func)(*this, value));
+    static setter_index<setters> const index(_setters);
+    setters const* found(index.find(key));
+    if (found)
+      return ((found->func)(*this, value));
   }
   catch (std::exception const& e) {
     logger(log_config_error, basic)
@@ -19,6 +19,7 @@
 
 #include <cstdio>
 #include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/engine/configuration/timeperiod.hh"
 #include "com/centreon/engine/configuration/timerange.hh"
 #include "com/centreon/engine/error.hh"
@@ -190,11 +191,10 @@ void timeperiod::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool timeperiod::parse(char const* key, char const* value) {
-  for (unsigned int i(0);
-       i < sizeof(_setters) / sizeof(_setters[0]);
-       ++i)
-    if (!strcmp(_setters[i].name, key))
-      return ((_setters[i].func)(*this, value));
+  static setter_index<setters> const index(_setters);
+  setters const* found(index.find(key));
+  if (found)
+    return ((found->func)(*this, value));
   return (_add_week_day(key, value));
 }
 
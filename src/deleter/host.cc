@@ -92,6 +92,10 @@ void deleter::host(void* ptr) throw () {
   obj->long_plugin_output = NULL;
   delete[] obj->perf_data;
   obj->perf_data = NULL;
+  delete[] obj->dependencies_ptr;
+  obj->dependencies_ptr = NULL;
+  delete[] obj->escalations_ptr;
+  obj->escalations_ptr = NULL;
 
   // event_handler_ptr not free.
   // check_command_ptr not free.
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/hostdependency.hh"
 #include "com/centreon/engine/objects/hostdependency.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,9 +34,9 @@ void deleter::hostdependency(void* ptr) throw () {
 
   hostdependency_struct* obj(static_cast<hostdependency_struct*>(ptr));
 
-  delete[] obj->dependent_host_name;
+  string::unintern(obj->dependent_host_name);
   obj->dependent_host_name = NULL;
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
   delete[] obj->dependency_period;
   obj->dependency_period = NULL;
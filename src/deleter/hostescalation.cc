@@ -24,6 +24,7 @@
 #include "com/centreon/engine/objects/contactgroupsmember.hh"
 #include "com/centreon/engine/objects/contactsmember.hh"
 #include "com/centreon/engine/objects/hostescalation.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -44,7 +45,7 @@ void deleter::hostescalation(void* ptr) throw () {
   // host_ptr not free.
   // escalation_period_ptr not free.
 
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
   delete[] obj->escalation_period;
   obj->escalation_period = NULL;
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/hostsmember.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,7 +34,7 @@ void deleter::hostsmember(void* ptr) throw () {
 
   hostsmember_struct* obj(static_cast<hostsmember_struct*>(ptr));
 
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
 
   delete obj;
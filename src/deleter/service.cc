@@ -28,6 +28,7 @@
 #include "com/centreon/engine/objects/customvariablesmember.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
 #include "com/centreon/engine/objects/service.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -47,9 +48,9 @@ void deleter::service(void* ptr) throw () {
   listmember(obj->custom_variables, &customvariablesmember);
   listmember(obj->servicegroups_ptr, &objectlist);
 
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
-  delete[] obj->description;
+  string::unintern(obj->description);
   obj->description = NULL;
   delete[] obj->display_name;
   obj->display_name = NULL;
@@ -83,6 +84,10 @@ void deleter::service(void* ptr) throw () {
   obj->event_handler_args = NULL;
   delete[] obj->check_command_args;
   obj->check_command_args = NULL;
+  delete[] obj->dependencies_ptr;
+  obj->dependencies_ptr = NULL;
+  delete[] obj->escalations_ptr;
+  obj->escalations_ptr = NULL;
 
   // host_ptr not free.
   // event_handler_ptr not free.
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/servicedependency.hh"
 #include "com/centreon/engine/objects/servicedependency.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,13 +34,13 @@ void deleter::servicedependency(void* ptr) throw () {
 
   servicedependency_struct* obj(static_cast<servicedependency_struct*>(ptr));
 
-  delete[] obj->dependent_host_name;
+  string::unintern(obj->dependent_host_name);
   obj->dependent_host_name = NULL;
-  delete[] obj->dependent_service_description;
+  string::unintern(obj->dependent_service_description);
   obj->dependent_service_description = NULL;
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
-  delete[] obj->service_description;
+  string::unintern(obj->service_description);
   obj->service_description = NULL;
   delete[] obj->dependency_period;
   obj->dependency_period = NULL;
@@ -24,6 +24,7 @@
 #include "com/centreon/engine/objects/contactgroupsmember.hh"
 #include "com/centreon/engine/objects/contactsmember.hh"
 #include "com/centreon/engine/objects/serviceescalation.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -44,9 +45,9 @@ void deleter::serviceescalation(void* ptr) throw () {
   // service_ptr not free.
   // escalation_period_ptr not free.
 
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
-  delete[] obj->description;
+  string::unintern(obj->description);
   obj->description = NULL;
   delete[] obj->escalation_period;
   obj->escalation_period = NULL;
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/deleter/servicesmember.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::engine;
 
@@ -33,9 +34,9 @@ void deleter::servicesmember(void* ptr) throw () {
 
   servicesmember_struct* obj(static_cast<servicesmember_struct*>(ptr));
 
-  delete[] obj->host_name;
+  string::unintern(obj->host_name);
   obj->host_name = NULL;
-  delete[] obj->service_description;
+  string::unintern(obj->service_description);
   obj->service_description = NULL;
 
   delete obj;
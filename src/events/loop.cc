@@ -27,6 +27,8 @@
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/logging/engine.hh"
 
@@ -217,6 +219,11 @@ void loop::_dispatching() {
       update_program_status(false);
     }
 
+    // Send elapsed notification digests and results of finished
+    // notification commands to the broker.
+    notifications::digest::instance().flush(current_time);
+    notifications::dispatcher::instance().reap();
+
     // Handle high priority events.
     bool run_event(true);
     if (event_list_high
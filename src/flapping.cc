@@ -26,6 +26,7 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
+#include "com/centreon/engine/state_history.hh"
 #include "com/centreon/engine/statusdata.hh"
 
 using namespace com::centreon::engine::logging;
@@ -41,15 +42,9 @@ void check_for_service_flapping(
        int allow_flapstart_notification) {
   int update_history = true;
   int is_flapping = false;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  int last_state_history_value = STATE_OK;
-  double curved_changes = 0.0;
   double curved_percent_change = 0.0;
   double low_threshold = 0.0;
   double high_threshold = 0.0;
-  double low_curve_value = 0.75;
-  double high_curve_value = 1.25;
 
   /* large install tweaks skips all flap detection logic - including state change calculation */
 
@@ -93,43 +88,18 @@ void check_for_service_flapping(
   }
 
   /* record current service state */
-  if (update_history == true) {
-    /* record the current state in the state history */
-    svc->state_history[svc->state_history_index] = svc->current_state;
-
-    /* increment state history index to next available slot */
-    svc->state_history_index++;
-    if (svc->state_history_index >= MAX_STATE_HISTORY_ENTRIES)
-      svc->state_history_index = 0;
-  }
-
-  /* calculate overall and curved percent state changes */
-  for (x = 0, y = svc->state_history_index; x < MAX_STATE_HISTORY_ENTRIES; x++) {
-    if (x == 0) {
-      last_state_history_value = svc->state_history[y];
-      y++;
-      if (y >= MAX_STATE_HISTORY_ENTRIES)
-        y = 0;
-      continue;
-    }
-
-    if (last_state_history_value != svc->state_history[y])
-      curved_changes
-        += (((double)(x - 1)
-             * (high_curve_value - low_curve_value))
-            / ((double)(MAX_STATE_HISTORY_ENTRIES - 2))) + low_curve_value;
-
-    last_state_history_value = svc->state_history[y];
-
-    y++;
-    if (y >= MAX_STATE_HISTORY_ENTRIES)
-      y = 0;
-  }
+  if (update_history == true)
+    push_state_history(
+      svc->state_history,
+      &svc->state_history_index,
+      &svc->state_changes,
+      svc->current_state);
 
   /* calculate overall percent change in state */
-  curved_percent_change
-    = (double)(((double)curved_changes * 100.0)
-               / (double)(MAX_STATE_HISTORY_ENTRIES - 1));
+  curved_percent_change = get_state_history_percent_change(
+                            &svc->state_changes,
+                            low_threshold,
+                            high_threshold);
 
   svc->percent_state_change = curved_percent_change;
 
@@ -193,17 +163,11 @@ void check_for_host_flapping(
        int allow_flapstart_notification) {
   int update_history = true;
   int is_flapping = false;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  int last_state_history_value = HOST_UP;
   unsigned long wait_threshold = 0L;
-  double curved_changes = 0.0;
   double curved_percent_change = 0.0;
   time_t current_time = 0L;
   double low_threshold = 0.0;
   double high_threshold = 0.0;
-  double low_curve_value = 0.75;
-  double high_curve_value = 1.25;
 
   logger(dbg_functions, basic)
     << "check_for_host_flapping()";
@@ -260,43 +224,18 @@ void check_for_host_flapping(
     hst->last_state_history_update = current_time;
 
     /* record the current state in the state history */
-    hst->state_history[hst->state_history_index] = hst->current_state;
-
-    /* increment state history index to next available slot */
-    hst->state_history_index++;
-    if (hst->state_history_index >= MAX_STATE_HISTORY_ENTRIES)
-      hst->state_history_index = 0;
-  }
-
-  /* calculate overall changes in state */
-  for (x = 0, y = hst->state_history_index;
-       x < MAX_STATE_HISTORY_ENTRIES;
-       x++) {
-
-    if (x == 0) {
-      last_state_history_value = hst->state_history[y];
-      y++;
-      if (y >= MAX_STATE_HISTORY_ENTRIES)
-        y = 0;
-      continue;
-    }
-
-    if (last_state_history_value != hst->state_history[y])
-      curved_changes
-        += (((double)(x - 1) * (high_curve_value - low_curve_value))
-            / ((double)(MAX_STATE_HISTORY_ENTRIES - 2))) + low_curve_value;
-
-    last_state_history_value = hst->state_history[y];
-
-    y++;
-    if (y >= MAX_STATE_HISTORY_ENTRIES)
-      y = 0;
+    push_state_history(
+      hst->state_history,
+      &hst->state_history_index,
+      &hst->state_changes,
+      hst->current_state);
   }
 
   /* calculate overall percent change in state */
-  curved_percent_change
-    = (double)(((double)curved_changes * 100.0)
-               / (double)(MAX_STATE_HISTORY_ENTRIES - 1));
+  curved_percent_change = get_state_history_percent_change(
+                            &hst->state_changes,
+                            low_threshold,
+                            high_threshold);
 
   hst->percent_state_change = curved_percent_change;
 
@@ -1168,6 +1168,8 @@ int init_macrox_names() {
   add_macrox_name(HOSTTIMEZONE);
   add_macrox_name(SERVICETIMEZONE);
   add_macrox_name(CONTACTTIMEZONE);
+  add_macrox_name(NOTIFICATIONDIGEST);
+  add_macrox_name(NOTIFICATIONDIGESTCOUNT);
 
   return (OK);
 }
@@ -39,6 +39,8 @@ int clear_host_macros_r(nagios_macros* mac) {
     MACRO_HOSTADDRESS,
     MACRO_HOSTSTATE,
     MACRO_HOSTSTATEID,
+    MACRO_LASTHOSTSTATE,
+    MACRO_LASTHOSTSTATEID,
     MACRO_HOSTCHECKTYPE,
     MACRO_HOSTSTATETYPE,
     MACRO_HOSTOUTPUT,
@@ -81,8 +83,8 @@ int clear_host_macros_r(nagios_macros* mac) {
   for (unsigned int i = 0;
        i < sizeof(to_free) / sizeof(*to_free);
        ++i) {
-    delete[] mac->x[i];
-    mac->x[i] = NULL;
+    delete[] mac->x[to_free[i]];
+    mac->x[to_free[i]] = NULL;
   }
 
   // Clear custom host variables.
@@ -33,7 +33,6 @@ extern "C" {
  */
 int clear_service_macros_r(nagios_macros* mac) {
   static unsigned int const to_free[] = {
-    MACRO_SERVICEDESC,
     MACRO_SERVICEDESC,
     MACRO_SERVICEDISPLAYNAME,
     MACRO_SERVICEOUTPUT,
@@ -45,6 +44,8 @@ int clear_service_macros_r(nagios_macros* mac) {
     MACRO_SERVICESTATE,
     MACRO_SERVICEISVOLATILE,
     MACRO_SERVICESTATEID,
+    MACRO_LASTSERVICESTATE,
+    MACRO_LASTSERVICESTATEID,
     MACRO_SERVICEATTEMPT,
     MACRO_MAXSERVICEATTEMPTS,
     MACRO_SERVICEEXECUTIONTIME,
@@ -75,8 +76,8 @@ int clear_service_macros_r(nagios_macros* mac) {
   for (unsigned int i = 0;
        i < sizeof(to_free) / sizeof(*to_free);
        ++i) {
-    delete[] mac->x[i];
-    mac->x[i] = NULL;
+    delete[] mac->x[to_free[i]];
+    mac->x[to_free[i]] = NULL;
   }
 
   // Clear custom service variables.
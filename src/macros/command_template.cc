@@ -0,0 +1,443 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/command_template.hh"
+#include "com/centreon/engine/macros/grab_value.hh"
+#include "com/centreon/unordered_hash.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::macros;
+
+// Compiled argument lists of the configured hosts and services,
+// indexed by full "command!arg1!arg2" string.
+static umap<std::string, shared_ptr<command_template::argument_list> >
+                           _arguments;
+static concurrency::mutex  _arguments_lock;
+
+/**
+ *  URL encode a string, the same way get_url_encoded_string() does.
+ *
+ *  @param[out] output  Encoded value is appended to this buffer.
+ *  @param[in]  value   Value to encode.
+ */
+static void url_encode(std::string& output, char const* value) {
+  static char const hex[] = "0123456789ABCDEF";
+  for (char const* ptr(value); *ptr; ++ptr) {
+    char c(*ptr);
+    if (((c >= '0') && (c <= '9'))
+        || ((c >= 'A') && (c <= 'Z'))
+        || ((c >= 'a') && (c <= 'z'))
+        || (c == '.') || (c == '-') || (c == '_') || (c == ':')
+        || (c == '/') || (c == '?') || (c == '=') || (c == '&'))
+      output.push_back(c);
+    else if (c == ' ')
+      output.push_back('+');
+    else {
+      unsigned char uc(static_cast<unsigned char>(c));
+      output.push_back('%');
+      output.push_back(hex[uc >> 4]);
+      output.push_back(hex[uc & 0x0F]);
+    }
+  }
+  return ;
+}
+
+/**
+ *  Append a macro value to an output buffer.
+ *
+ *  @param[out] output      Output buffer.
+ *  @param[in]  name        Macro name (for logging purpose).
+ *  @param[in]  result      Result of the macro grabbing.
+ *  @param[in]  value       Macro value.
+ *  @param[in]  free_macro  true if value must be deleted.
+ *  @param[in]  options     Effective clean options.
+ */
+static void append_macro(
+              std::string& output,
+              std::string const& name,
+              int result,
+              char* value,
+              int free_macro,
+              int options) {
+  // An error occurred, we couldn't parse the macro.
+  if (result == ERROR) {
+    logger(dbg_macros, basic)
+      << " WARNING: An error occurred processing macro '"
+      << name << "'!";
+    if (free_macro) {
+      delete[] value;
+      value = NULL;
+    }
+  }
+  if (!value)
+    return ;
+
+  size_t start(output.size());
+
+  // URL encode the macro if requested.
+  if (options & URL_ENCODE_MACRO_CHARS)
+    url_encode(output, value);
+  else
+    output.append(value);
+
+  // Strip illegal characters of the appended value.
+  if (options & STRIP_ILLEGAL_MACRO_CHARS) {
+    std::string const& illegal(config->illegal_output_chars());
+    size_t kept(start);
+    for (size_t i(start), end(output.size()); i < end; ++i) {
+      int ch(static_cast<unsigned char>(output[i]));
+      if ((ch < 32)
+          || (ch == 127)
+          || (illegal.find(output[i]) != std::string::npos))
+        continue ;
+      output[kept++] = output[i];
+    }
+    output.resize(kept);
+  }
+
+  if (free_macro)
+    delete[] value;
+  return ;
+}
+
+/**
+ *  Default constructor.
+ */
+command_template::command_template()
+  : _literal_size(0) {}
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] line  Command line to compile.
+ */
+command_template::command_template(std::string const& line)
+  : _literal_size(0) {
+  compile(line);
+}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] other  Object to copy.
+ */
+command_template::command_template(command_template const& other)
+  : _line(other._line),
+    _literal_size(other._literal_size),
+    _tokens(other._tokens) {}
+
+/**
+ *  Destructor.
+ */
+command_template::~command_template() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] other  Object to copy.
+ *
+ *  @return This object.
+ */
+command_template& command_template::operator=(
+                    command_template const& other) {
+  if (this != &other) {
+    _line = other._line;
+    _literal_size = other._literal_size;
+    _tokens = other._tokens;
+  }
+  return (*this);
+}
+
+/**
+ *  Drop all compiled argument lists. Must be called when the
+ *  configuration (user macros, objects) is reloaded.
+ */
+void command_template::clear_arguments() {
+  concurrency::locker lock(&_arguments_lock);
+  _arguments.clear();
+  return ;
+}
+
+/**
+ *  Compile a command line. The line is split in the exact same way
+ *  process_macros_r() used to split it.
+ *
+ *  @param[in] line  Command line.
+ */
+void command_template::compile(std::string const& line) {
+  _line = line;
+  _literal_size = 0;
+  _tokens.clear();
+
+  bool in_macro(false);
+  size_t pos(0);
+  while (true) {
+    size_t delim(line.find('$', pos));
+    size_t end((delim == std::string::npos) ? line.size() : delim);
+    if (!in_macro)
+      _add_literal(line.data() + pos, end - pos);
+    else
+      _add_macro(line.substr(pos, end - pos));
+    in_macro = !in_macro;
+    if (delim == std::string::npos)
+      break ;
+    pos = delim + 1;
+  }
+  return ;
+}
+
+/**
+ *  Expand command line.
+ *
+ *  @param[in]     mac      Macros.
+ *  @param[in,out] output   Expanded command line is appended to this
+ *                          buffer.
+ *  @param[in]     options  Global clean options.
+ */
+void command_template::expand(
+                         nagios_macros* mac,
+                         std::string& output,
+                         int options) const {
+  output.reserve(output.size() + _literal_size);
+  for (std::vector<token>::const_iterator
+         it(_tokens.begin()), end(_tokens.end());
+       it != end;
+       ++it) {
+    switch (it->type) {
+    case token_literal:
+      output.append(it->text);
+      break ;
+    case token_standard:
+      {
+        char* value(NULL);
+        int free_macro(true);
+        int result(grab_macrox_value_r(
+                     mac,
+                     it->id,
+                     it->has_arg1 ? it->arg1.c_str() : NULL,
+                     it->has_arg2 ? it->arg2.c_str() : NULL,
+                     &value,
+                     &free_macro));
+        append_macro(
+          output,
+          it->text,
+          result,
+          value,
+          free_macro,
+          options | it->clean_options);
+      }
+      break ;
+    case token_argv:
+      append_macro(output, it->text, OK, mac->argv[it->id], false, options);
+      break ;
+    case token_user:
+      append_macro(output, it->text, OK, macro_user[it->id], false, options);
+      break ;
+    case token_other:
+      {
+        char* value(NULL);
+        int clean_options(0);
+        int free_macro(false);
+        int result(grab_macro_value_r(
+                     mac,
+                     const_cast<char*>(it->text.c_str()),
+                     &value,
+                     &clean_options,
+                     &free_macro));
+        append_macro(
+          output,
+          it->text,
+          result,
+          value,
+          free_macro,
+          options | clean_options);
+      }
+      break ;
+    }
+  }
+  return ;
+}
+
+/**
+ *  Get the compiled arguments of a command. Arguments are split the
+ *  same way get_raw_command_line_r() used to split them.
+ *
+ *  Only the check commands of configured hosts and services are
+ *  cached, so that the cache is bounded by the configuration. Other
+ *  commands (from external commands for example) are compiled on
+ *  each call.
+ *
+ *  @param[in] cmd    Command with its arguments ("cmd!arg1!arg2").
+ *  @param[in] cache  true to keep the compiled arguments until the
+ *                    next call to clear_arguments().
+ *
+ *  @return Compiled arguments.
+ */
+shared_ptr<command_template::argument_list>
+  command_template::get_arguments(char const* cmd, bool cache) {
+  concurrency::locker lock(&_arguments_lock);
+  std::string key(cmd ? cmd : "");
+  umap<std::string, shared_ptr<argument_list> >::const_iterator
+    found(_arguments.find(key));
+  if (found != _arguments.end())
+    return (found->second);
+
+  shared_ptr<argument_list> args(new argument_list);
+  if (cmd) {
+    // Skip the command name.
+    unsigned int arg_index(0);
+    while (cmd[arg_index] != '!' && cmd[arg_index] != '\0')
+      ++arg_index;
+
+    // Get each command argument.
+    bool escaped(false);
+    std::string arg;
+    for (unsigned int x(0); x < MAX_COMMAND_ARGUMENTS; ++x) {
+      if (cmd[arg_index] == '\0')
+        break ;
+      arg.clear();
+      for (++arg_index;
+           arg.size() < MAX_COMMAND_BUFFER - 1;
+           ++arg_index) {
+        // Backslashes escape.
+        if ((cmd[arg_index] == '\\') && !escaped) {
+          escaped = true;
+          continue ;
+        }
+        // End of argument.
+        if (((cmd[arg_index] == '!') && !escaped)
+            || (cmd[arg_index] == '\0'))
+          break ;
+        // Normal or escaped char.
+        arg.push_back(cmd[arg_index]);
+        escaped = false;
+      }
+      args->push_back(command_template(arg));
+    }
+  }
+  if (cache)
+    _arguments[key] = args;
+  return (args);
+}
+
+/**
+ *  Get the original command line.
+ *
+ *  @return Command line.
+ */
+std::string const& command_template::get_line() const throw () {
+  return (_line);
+}
+
+/**
+ *  Add a literal token.
+ *
+ *  @param[in] text  Literal text.
+ *  @param[in] size  Text size.
+ */
+void command_template::_add_literal(char const* text, size_t size) {
+  if (!size)
+    return ;
+  if (_tokens.empty() || (_tokens.back().type != token_literal)) {
+    token t;
+    t.type = token_literal;
+    t.id = 0;
+    t.clean_options = 0;
+    t.has_arg1 = false;
+    t.has_arg2 = false;
+    _tokens.push_back(t);
+  }
+  _tokens.back().text.append(text, size);
+  _literal_size += size;
+  return ;
+}
+
+/**
+ *  Add a macro token.
+ *
+ *  @param[in] name  Text found between two '$'.
+ */
+void command_template::_add_macro(std::string const& name) {
+  // An escaped $ is done by specifying two $$ next to each other.
+  if (name.empty()) {
+    _add_literal("$", 1);
+    return ;
+  }
+
+  token t;
+  t.type = token_other;
+  t.id = 0;
+  t.clean_options = 0;
+  t.text = name;
+  t.has_arg1 = false;
+  t.has_arg2 = false;
+
+  // Split macro name and arguments.
+  std::string macro_name;
+  size_t delim(name.find(':'));
+  if (delim == std::string::npos)
+    macro_name = name;
+  else {
+    macro_name = name.substr(0, delim);
+    size_t next(name.find(':', delim + 1));
+    t.has_arg1 = true;
+    if (next == std::string::npos)
+      t.arg1 = name.substr(delim + 1);
+    else {
+      t.arg1 = name.substr(delim + 1, next - delim - 1);
+      t.has_arg2 = true;
+      t.arg2 = name.substr(next + 1);
+    }
+  }
+
+  int id(find_macrox(macro_name.c_str()));
+  if (id >= 0) {
+    t.type = token_standard;
+    t.id = id;
+    t.clean_options = get_macrox_clean_options(id);
+  }
+  else if (macro_name.compare(0, 3, "ARG") == 0) {
+    int x(atoi(macro_name.c_str() + 3));
+    // Invalid $ARGn$ macros are silently dropped.
+    if ((x <= 0) || (x > MAX_COMMAND_ARGUMENTS))
+      return ;
+    t.type = token_argv;
+    t.id = x - 1;
+  }
+  else if (macro_name.compare(0, 4, "USER") == 0) {
+    int x(atoi(macro_name.c_str() + 4));
+    // Invalid $USERn$ macros are silently dropped.
+    if ((x <= 0) || (x > MAX_USER_MACROS))
+      return ;
+    t.type = token_user;
+    t.id = x - 1;
+  }
+  _tokens.push_back(t);
+  return ;
+}
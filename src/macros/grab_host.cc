@@ -27,6 +27,7 @@
 #include "com/centreon/engine/macros/grab.hh"
 #include "com/centreon/engine/macros/grab_host.hh"
 #include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/objects/objectlist.hh"
 #include "com/centreon/engine/objects/servicesmember.hh"
 #include "com/centreon/engine/objects/hostsmember.hh"
@@ -55,36 +56,16 @@ static void generate_host_total_services(
   // Generate host service summary macros
   // (if they haven't already been computed).
   if (!mac->x[MACRO_TOTALHOSTSERVICES]) {
-    unsigned long total_host_services(0);
-    unsigned long total_host_services_ok(0);
-    unsigned long total_host_services_warning(0);
-    unsigned long total_host_services_unknown(0);
-    unsigned long total_host_services_critical(0);
-    for (servicesmember* temp_servicesmember = hst.services;
-         temp_servicesmember != NULL;
-         temp_servicesmember = temp_servicesmember->next) {
-      service* temp_service(temp_servicesmember->service_ptr);
-      if (temp_service) {
-        total_host_services++;
-        switch (temp_service->current_state) {
-         case STATE_OK:
-          total_host_services_ok++;
-          break;
-         case STATE_WARNING:
-          total_host_services_warning++;
-          break;
-         case STATE_UNKNOWN:
-          total_host_services_unknown++;
-          break;
-         case STATE_CRITICAL:
-          total_host_services_critical++;
-          break;
-        }
-      }
-    }
+    summary::host_services const&
+      totals(summary::instance().get_host_services(&hst));
+    unsigned long total_host_services(totals.total);
+    unsigned long total_host_services_ok(totals.ok);
+    unsigned long total_host_services_warning(totals.warning);
+    unsigned long total_host_services_unknown(totals.unknown);
+    unsigned long total_host_services_critical(totals.critical);
 
-    // These macros are time-intensive to compute, and will likely be
-    // used together, so save them all for future use.
+    // These macros will likely be used together,
+    // so save them all for future use.
     string::setstr(mac->x[MACRO_TOTALHOSTSERVICES], total_host_services);
     string::setstr(mac->x[MACRO_TOTALHOSTSERVICESOK], total_host_services_ok);
     string::setstr(mac->x[MACRO_TOTALHOSTSERVICESWARNING], total_host_services_warning);
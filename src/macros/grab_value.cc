@@ -18,10 +18,12 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cstdlib>
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros/grab_value.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/unordered_hash.hh"
@@ -58,19 +60,34 @@ static int handle_host_macro(
              int* free_macro) {
   int retval;
   if (arg2 == NULL) {
-    // Find the host for on-demand macros
-    // or use saved host pointer.
-    host* hst(arg1 ? find_host(arg1) : mac->host_ptr);
-    if (hst)
-      // Get the host macro value.
-      retval = grab_standard_host_macro_r(
-                 mac,
-                 macro_type,
-                 hst,
-                 output,
-                 free_macro);
-    else
-      retval = ERROR;
+    // Macro of the saved host was already computed.
+    if (!arg1 && mac->host_ptr && mac->x[macro_type]) {
+      *output = mac->x[macro_type];
+      *free_macro = false;
+      retval = OK;
+    }
+    else {
+      // Find the host for on-demand macros
+      // or use saved host pointer.
+      host* hst(arg1 ? find_host(arg1) : mac->host_ptr);
+      if (hst) {
+        // Get the host macro value.
+        retval = grab_standard_host_macro_r(
+                   mac,
+                   macro_type,
+                   hst,
+                   output,
+                   free_macro);
+
+        // Keep value of the saved host until its macros are cleared.
+        if (!arg1 && (retval == OK) && *free_macro) {
+          mac->x[macro_type] = *output;
+          *free_macro = false;
+        }
+      }
+      else
+        retval = ERROR;
+    }
   }
   // A host macro with a hostgroup name and delimiter.
   else {
@@ -188,13 +205,26 @@ static int handle_service_macro(
   if (!arg1 && !arg2) {
     if (!mac->service_ptr)
       retval = ERROR;
-    else
+    // Macro of the saved service was already computed.
+    else if (mac->x[macro_type]) {
+      *output = mac->x[macro_type];
+      *free_macro = false;
+      retval = OK;
+    }
+    else {
       retval = grab_standard_service_macro_r(
                  mac,
                  macro_type,
                  mac->service_ptr,
                  output,
                  free_macro);
+
+      // Keep value of the saved service until its macros are cleared.
+      if ((retval == OK) && *free_macro) {
+        mac->x[macro_type] = *output;
+        *free_macro = false;
+      }
+    }
   }
   // Else and ondemand macro...
   else {
@@ -573,139 +603,35 @@ static int handle_summary_macro(
 
   // Generate summary macros if needed.
   if (!mac->x[MACRO_TOTALHOSTSUP]) {
-    // Get host totals.
-    unsigned int host_problems(0);
-    unsigned int host_problems_unhandled(0);
-    unsigned int hosts_down(0);
-    unsigned int hosts_down_unhandled(0);
-    unsigned int hosts_unreachable(0);
-    unsigned int hosts_unreachable_unhandled(0);
-    unsigned int hosts_up(0);
-    for (host* temp_host = host_list;
-         temp_host != NULL;
-         temp_host = temp_host->next) {
-      // Filter totals based on contact if necessary.
-      bool authorized(
-             mac->contact_ptr
-             ? is_contact_for_host(temp_host, mac->contact_ptr)
-             : true);
-      if (authorized) {
-        bool problem(true);
-        if ((temp_host->current_state == HOST_UP)
-            && (temp_host->has_been_checked == true))
-          hosts_up++;
-        else if (temp_host->current_state == HOST_DOWN) {
-          if (temp_host->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_host->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_host->checks_enabled == false)
-            problem = false;
-          if (problem)
-            hosts_down_unhandled++;
-          hosts_down++;
-        }
-        else if (temp_host->current_state == HOST_UNREACHABLE) {
-          if (temp_host->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_host->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_host->checks_enabled == false)
-            problem = false;
-          if (problem)
-            hosts_down_unhandled++;
-          hosts_unreachable++;
-        }
-      }
-    }
-    host_problems = hosts_down + hosts_unreachable;
-    host_problems_unhandled
-      = hosts_down_unhandled + hosts_unreachable_unhandled;
-
-    // Get service totals.
-    unsigned int service_problems(0);
-    unsigned int service_problems_unhandled(0);
-    unsigned int services_critical(0);
-    unsigned int services_critical_unhandled(0);
-    unsigned int services_ok(0);
-    unsigned int services_unknown(0);
-    unsigned int services_unknown_unhandled(0);
-    unsigned int services_warning(0);
-    unsigned int services_warning_unhandled(0);
-    for (service* temp_service = service_list;
-         temp_service != NULL;
-         temp_service = temp_service->next) {
-      // Filter totals based on contact if necessary.
-      bool authorized(
-             mac->contact_ptr
-             ? is_contact_for_service(
-                 temp_service,
-                 mac->contact_ptr)
-             : true);
-      if (authorized) {
-        bool problem(true);
-        if (temp_service->current_state == STATE_OK
-            && temp_service->has_been_checked == true)
-          services_ok++;
-        else if (temp_service->current_state == STATE_WARNING) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_warning_unhandled++;
-          services_warning++;
-        }
-        else if (temp_service->current_state == STATE_UNKNOWN) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_unknown_unhandled++;
-          services_unknown++;
-        }
-        else if (temp_service->current_state == STATE_CRITICAL) {
-          host* temp_host(find_host(temp_service->host_name));
-          if (temp_host != NULL
-              && (temp_host->current_state == HOST_DOWN
-                  || temp_host->current_state == HOST_UNREACHABLE))
-            problem = false;
-          if (temp_service->scheduled_downtime_depth > 0)
-            problem = false;
-          if (temp_service->problem_has_been_acknowledged == true)
-            problem = false;
-          if (temp_service->checks_enabled == false)
-            problem = false;
-          if (problem)
-            services_critical_unhandled++;
-          services_critical++;
-        }
-      }
-    }
-    service_problems
-      = services_warning + services_critical + services_unknown;
-    service_problems_unhandled
-      = services_warning_unhandled
-      + services_critical_unhandled
-      + services_unknown_unhandled;
-
-    // These macros are time-intensive to compute, and will likely be
-    // used together, so save them all for future use.
+    // Totals are filtered based on contact if necessary.
+    macros::summary::totals const&
+      t(macros::summary::instance().get_totals(mac->contact_ptr));
+    unsigned int hosts_up(t.hosts_up);
+    unsigned int hosts_down(t.hosts_down);
+    unsigned int hosts_down_unhandled(t.hosts_down_unhandled);
+    unsigned int hosts_unreachable(t.hosts_unreachable);
+    unsigned int hosts_unreachable_unhandled(
+                   t.hosts_unreachable_unhandled);
+    unsigned int host_problems(hosts_down + hosts_unreachable);
+    unsigned int host_problems_unhandled(
+                   hosts_down_unhandled + hosts_unreachable_unhandled);
+    unsigned int services_ok(t.services_ok);
+    unsigned int services_warning(t.services_warning);
+    unsigned int services_warning_unhandled(t.services_warning_unhandled);
+    unsigned int services_unknown(t.services_unknown);
+    unsigned int services_unknown_unhandled(t.services_unknown_unhandled);
+    unsigned int services_critical(t.services_critical);
+    unsigned int services_critical_unhandled(
+                   t.services_critical_unhandled);
+    unsigned int service_problems(
+                   services_warning + services_critical + services_unknown);
+    unsigned int service_problems_unhandled(
+                   services_warning_unhandled
+                   + services_critical_unhandled
+                   + services_unknown_unhandled);
+
+    // These macros will likely be used together,
+    // so save them all for future use.
     string::setstr(mac->x[MACRO_TOTALHOSTSUP], hosts_up);
     string::setstr(mac->x[MACRO_TOTALHOSTSDOWN], hosts_down);
     string::setstr(mac->x[MACRO_TOTALHOSTSUNREACHABLE], hosts_unreachable);
@@ -915,7 +841,9 @@ struct grab_value_redirection {
       MACRO_NOTIFICATIONAUTHOR,
       MACRO_NOTIFICATIONAUTHORNAME,
       MACRO_NOTIFICATIONAUTHORALIAS,
-      MACRO_NOTIFICATIONCOMMENT
+      MACRO_NOTIFICATIONCOMMENT,
+      MACRO_NOTIFICATIONDIGEST,
+      MACRO_NOTIFICATIONDIGESTCOUNT
     };
     for (unsigned int i = 0;
          i < sizeof(notification_ids) / sizeof(*notification_ids);
@@ -1053,42 +981,29 @@ int grab_macro_value_r(
 
   /***** X MACROS *****/
   /* see if this is an x macro */
-  for (x = 0; x < MACRO_X_COUNT; x++) {
-    if (macro_x_names[x] == NULL)
-      continue;
+  int macro_id(macros::find_macrox(macro_name));
+  if (macro_id >= 0) {
+    x = macro_id;
+    logger(dbg_macros, most)
+      << "  macros[" << x << "] (" << macro_name << ") match.";
 
-    if (!strcmp(macro_name, macro_x_names[x])) {
-      logger(dbg_macros, most)
-        << "  macros[" << x << "] (" << macro_x_names[x] << ") match.";
-
-      /* get the macro value */
-      result = grab_macrox_value_r(
-                 mac,
-                 x,
-                 arg[0],
-                 arg[1],
-                 output,
-                 free_macro);
-
-      /* post-processing */
-      /* host/service output/perfdata and author/comment macros should get cleaned */
-      if ((x >= 16 && x <= 19) || (x >= 49 && x <= 52)
-          || (x >= 99 && x <= 100) || (x >= 124 && x <= 127)) {
-        *clean_options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
-        logger(dbg_macros, most)
-          << "  New clean options: " << *clean_options;
-      }
-      /* url macros should get cleaned */
-      if ((x >= 125 && x <= 126) || (x >= 128 && x <= 129)
-          || (x >= 77 && x <= 78) || (x >= 74 && x <= 75)) {
-        *clean_options |= URL_ENCODE_MACRO_CHARS;
-        logger(dbg_macros, most)
-          << "  New clean options: " << *clean_options;
-      }
-
-      break;
-    }
+    /* get the macro value */
+    result = grab_macrox_value_r(
+               mac,
+               x,
+               arg[0],
+               arg[1],
+               output,
+               free_macro);
+
+    /* post-processing */
+    /* output/perfdata, author/comment and url macros should get cleaned */
+    *clean_options |= macros::get_macrox_clean_options(x);
+    logger(dbg_macros, most)
+      << "  New clean options: " << *clean_options;
   }
+  else
+    x = MACRO_X_COUNT;
 
   /* we already found the macro... */
   if (x < MACRO_X_COUNT)
@@ -1311,3 +1226,239 @@ int grab_macrox_value(
 }
 
 }
+
+// Standard macro names, sorted in strcmp() order. This table must be
+// kept in sync with init_macrox_names().
+struct macrox_entry {
+  char const*  name;
+  unsigned int id;
+};
+static macrox_entry const macrox_table[] = {
+  { "ADMINEMAIL",                     MACRO_ADMINEMAIL },
+  { "ADMINPAGER",                     MACRO_ADMINPAGER },
+  { "COMMANDFILE",                    MACRO_COMMANDFILE },
+  { "CONTACTALIAS",                   MACRO_CONTACTALIAS },
+  { "CONTACTEMAIL",                   MACRO_CONTACTEMAIL },
+  { "CONTACTGROUPALIAS",              MACRO_CONTACTGROUPALIAS },
+  { "CONTACTGROUPMEMBERS",            MACRO_CONTACTGROUPMEMBERS },
+  { "CONTACTGROUPNAME",               MACRO_CONTACTGROUPNAME },
+  { "CONTACTGROUPNAMES",              MACRO_CONTACTGROUPNAMES },
+  { "CONTACTNAME",                    MACRO_CONTACTNAME },
+  { "CONTACTPAGER",                   MACRO_CONTACTPAGER },
+  { "CONTACTTIMEZONE",                MACRO_CONTACTTIMEZONE },
+  { "CONTACTTOKEN",                   MACRO_CONTACTTOKEN },
+  { "DATE",                           MACRO_DATE },
+  { "EVENTSTARTTIME",                 MACRO_EVENTSTARTTIME },
+  { "HOSTACKAUTHOR",                  MACRO_HOSTACKAUTHOR },
+  { "HOSTACKAUTHORALIAS",             MACRO_HOSTACKAUTHORALIAS },
+  { "HOSTACKAUTHORNAME",              MACRO_HOSTACKAUTHORNAME },
+  { "HOSTACKCOMMENT",                 MACRO_HOSTACKCOMMENT },
+  { "HOSTACTIONURL",                  MACRO_HOSTACTIONURL },
+  { "HOSTADDRESS",                    MACRO_HOSTADDRESS },
+  { "HOSTALIAS",                      MACRO_HOSTALIAS },
+  { "HOSTATTEMPT",                    MACRO_HOSTATTEMPT },
+  { "HOSTCHECKCOMMAND",               MACRO_HOSTCHECKCOMMAND },
+  { "HOSTCHECKTYPE",                  MACRO_HOSTCHECKTYPE },
+  { "HOSTCHILDREN",                   MACRO_HOSTCHILDREN },
+  { "HOSTDISPLAYNAME",                MACRO_HOSTDISPLAYNAME },
+  { "HOSTDOWNTIME",                   MACRO_HOSTDOWNTIME },
+  { "HOSTDURATION",                   MACRO_HOSTDURATION },
+  { "HOSTDURATIONSEC",                MACRO_HOSTDURATIONSEC },
+  { "HOSTEVENTID",                    MACRO_HOSTEVENTID },
+  { "HOSTEXECUTIONTIME",              MACRO_HOSTEXECUTIONTIME },
+  { "HOSTGROUPACTIONURL",             MACRO_HOSTGROUPACTIONURL },
+  { "HOSTGROUPALIAS",                 MACRO_HOSTGROUPALIAS },
+  { "HOSTGROUPMEMBERS",               MACRO_HOSTGROUPMEMBERS },
+  { "HOSTGROUPNAME",                  MACRO_HOSTGROUPNAME },
+  { "HOSTGROUPNAMES",                 MACRO_HOSTGROUPNAMES },
+  { "HOSTGROUPNOTES",                 MACRO_HOSTGROUPNOTES },
+  { "HOSTGROUPNOTESURL",              MACRO_HOSTGROUPNOTESURL },
+  { "HOSTID",                         MACRO_HOSTID },
+  { "HOSTLATENCY",                    MACRO_HOSTLATENCY },
+  { "HOSTNAME",                       MACRO_HOSTNAME },
+  { "HOSTNOTES",                      MACRO_HOSTNOTES },
+  { "HOSTNOTESURL",                   MACRO_HOSTNOTESURL },
+  { "HOSTNOTIFICATIONID",             MACRO_HOSTNOTIFICATIONID },
+  { "HOSTNOTIFICATIONNUMBER",         MACRO_HOSTNOTIFICATIONNUMBER },
+  { "HOSTOUTPUT",                     MACRO_HOSTOUTPUT },
+  { "HOSTPARENTS",                    MACRO_HOSTPARENTS },
+  { "HOSTPERCENTCHANGE",              MACRO_HOSTPERCENTCHANGE },
+  { "HOSTPERFDATA",                   MACRO_HOSTPERFDATA },
+  { "HOSTPERFDATAFILE",               MACRO_HOSTPERFDATAFILE },
+  { "HOSTPROBLEMID",                  MACRO_HOSTPROBLEMID },
+  { "HOSTSTATE",                      MACRO_HOSTSTATE },
+  { "HOSTSTATEID",                    MACRO_HOSTSTATEID },
+  { "HOSTSTATETYPE",                  MACRO_HOSTSTATETYPE },
+  { "HOSTTIMEZONE",                   MACRO_HOSTTIMEZONE },
+  { "ISVALIDTIME",                    MACRO_ISVALIDTIME },
+  { "LASTHOSTCHECK",                  MACRO_LASTHOSTCHECK },
+  { "LASTHOSTDOWN",                   MACRO_LASTHOSTDOWN },
+  { "LASTHOSTEVENTID",                MACRO_LASTHOSTEVENTID },
+  { "LASTHOSTPROBLEMID",              MACRO_LASTHOSTPROBLEMID },
+  { "LASTHOSTSTATE",                  MACRO_LASTHOSTSTATE },
+  { "LASTHOSTSTATECHANGE",            MACRO_LASTHOSTSTATECHANGE },
+  { "LASTHOSTSTATEID",                MACRO_LASTHOSTSTATEID },
+  { "LASTHOSTUNREACHABLE",            MACRO_LASTHOSTUNREACHABLE },
+  { "LASTHOSTUP",                     MACRO_LASTHOSTUP },
+  { "LASTSERVICECHECK",               MACRO_LASTSERVICECHECK },
+  { "LASTSERVICECRITICAL",            MACRO_LASTSERVICECRITICAL },
+  { "LASTSERVICEEVENTID",             MACRO_LASTSERVICEEVENTID },
+  { "LASTSERVICEOK",                  MACRO_LASTSERVICEOK },
+  { "LASTSERVICEPROBLEMID",           MACRO_LASTSERVICEPROBLEMID },
+  { "LASTSERVICESTATE",               MACRO_LASTSERVICESTATE },
+  { "LASTSERVICESTATECHANGE",         MACRO_LASTSERVICESTATECHANGE },
+  { "LASTSERVICESTATEID",             MACRO_LASTSERVICESTATEID },
+  { "LASTSERVICEUNKNOWN",             MACRO_LASTSERVICEUNKNOWN },
+  { "LASTSERVICEWARNING",             MACRO_LASTSERVICEWARNING },
+  { "LOGFILE",                        MACRO_LOGFILE },
+  { "LONGDATETIME",                   MACRO_LONGDATETIME },
+  { "LONGHOSTOUTPUT",                 MACRO_LONGHOSTOUTPUT },
+  { "LONGSERVICEOUTPUT",              MACRO_LONGSERVICEOUTPUT },
+  { "MAINCONFIGFILE",                 MACRO_MAINCONFIGFILE },
+  { "MAXHOSTATTEMPTS",                MACRO_MAXHOSTATTEMPTS },
+  { "MAXSERVICEATTEMPTS",             MACRO_MAXSERVICEATTEMPTS },
+  { "NEXTVALIDTIME",                  MACRO_NEXTVALIDTIME },
+  { "NOTIFICATIONAUTHOR",             MACRO_NOTIFICATIONAUTHOR },
+  { "NOTIFICATIONAUTHORALIAS",        MACRO_NOTIFICATIONAUTHORALIAS },
+  { "NOTIFICATIONAUTHORNAME",         MACRO_NOTIFICATIONAUTHORNAME },
+  { "NOTIFICATIONCOMMENT",            MACRO_NOTIFICATIONCOMMENT },
+  { "NOTIFICATIONDIGEST",             MACRO_NOTIFICATIONDIGEST },
+  { "NOTIFICATIONDIGESTCOUNT",        MACRO_NOTIFICATIONDIGESTCOUNT },
+  { "NOTIFICATIONISESCALATED",        MACRO_NOTIFICATIONISESCALATED },
+  { "NOTIFICATIONNUMBER",             MACRO_NOTIFICATIONNUMBER },
+  { "NOTIFICATIONRECIPIENTS",         MACRO_NOTIFICATIONRECIPIENTS },
+  { "NOTIFICATIONTYPE",               MACRO_NOTIFICATIONTYPE },
+  { "OBJECTCACHEFILE",                MACRO_OBJECTCACHEFILE },
+  { "PROCESSSTARTTIME",               MACRO_PROCESSSTARTTIME },
+  { "RESOURCEFILE",                   MACRO_RESOURCEFILE },
+  { "RETENTIONDATAFILE",              MACRO_RETENTIONDATAFILE },
+  { "SERVICEACKAUTHOR",               MACRO_SERVICEACKAUTHOR },
+  { "SERVICEACKAUTHORALIAS",          MACRO_SERVICEACKAUTHORALIAS },
+  { "SERVICEACKAUTHORNAME",           MACRO_SERVICEACKAUTHORNAME },
+  { "SERVICEACKCOMMENT",              MACRO_SERVICEACKCOMMENT },
+  { "SERVICEACTIONURL",               MACRO_SERVICEACTIONURL },
+  { "SERVICEATTEMPT",                 MACRO_SERVICEATTEMPT },
+  { "SERVICECHECKCOMMAND",            MACRO_SERVICECHECKCOMMAND },
+  { "SERVICECHECKTYPE",               MACRO_SERVICECHECKTYPE },
+  { "SERVICEDESC",                    MACRO_SERVICEDESC },
+  { "SERVICEDISPLAYNAME",             MACRO_SERVICEDISPLAYNAME },
+  { "SERVICEDOWNTIME",                MACRO_SERVICEDOWNTIME },
+  { "SERVICEDURATION",                MACRO_SERVICEDURATION },
+  { "SERVICEDURATIONSEC",             MACRO_SERVICEDURATIONSEC },
+  { "SERVICEEVENTID",                 MACRO_SERVICEEVENTID },
+  { "SERVICEEXECUTIONTIME",           MACRO_SERVICEEXECUTIONTIME },
+  { "SERVICEGROUPACTIONURL",          MACRO_SERVICEGROUPACTIONURL },
+  { "SERVICEGROUPALIAS",              MACRO_SERVICEGROUPALIAS },
+  { "SERVICEGROUPMEMBERS",            MACRO_SERVICEGROUPMEMBERS },
+  { "SERVICEGROUPNAME",               MACRO_SERVICEGROUPNAME },
+  { "SERVICEGROUPNAMES",              MACRO_SERVICEGROUPNAMES },
+  { "SERVICEGROUPNOTES",              MACRO_SERVICEGROUPNOTES },
+  { "SERVICEGROUPNOTESURL",           MACRO_SERVICEGROUPNOTESURL },
+  { "SERVICEID",                      MACRO_SERVICEID },
+  { "SERVICEISVOLATILE",              MACRO_SERVICEISVOLATILE },
+  { "SERVICELATENCY",                 MACRO_SERVICELATENCY },
+  { "SERVICENOTES",                   MACRO_SERVICENOTES },
+  { "SERVICENOTESURL",                MACRO_SERVICENOTESURL },
+  { "SERVICENOTIFICATIONID",          MACRO_SERVICENOTIFICATIONID },
+  { "SERVICENOTIFICATIONNUMBER",      MACRO_SERVICENOTIFICATIONNUMBER },
+  { "SERVICEOUTPUT",                  MACRO_SERVICEOUTPUT },
+  { "SERVICEPERCENTCHANGE",           MACRO_SERVICEPERCENTCHANGE },
+  { "SERVICEPERFDATA",                MACRO_SERVICEPERFDATA },
+  { "SERVICEPERFDATAFILE",            MACRO_SERVICEPERFDATAFILE },
+  { "SERVICEPROBLEMID",               MACRO_SERVICEPROBLEMID },
+  { "SERVICESTATE",                   MACRO_SERVICESTATE },
+  { "SERVICESTATEID",                 MACRO_SERVICESTATEID },
+  { "SERVICESTATETYPE",               MACRO_SERVICESTATETYPE },
+  { "SERVICETIMEZONE",                MACRO_SERVICETIMEZONE },
+  { "SHORTDATETIME",                  MACRO_SHORTDATETIME },
+  { "STATUSDATAFILE",                 MACRO_STATUSDATAFILE },
+  { "TEMPFILE",                       MACRO_TEMPFILE },
+  { "TEMPPATH",                       MACRO_TEMPPATH },
+  { "TIME",                           MACRO_TIME },
+  { "TIMET",                          MACRO_TIMET },
+  { "TOTALHOSTPROBLEMS",              MACRO_TOTALHOSTPROBLEMS },
+  { "TOTALHOSTPROBLEMSUNHANDLED",     MACRO_TOTALHOSTPROBLEMSUNHANDLED },
+  { "TOTALHOSTSDOWN",                 MACRO_TOTALHOSTSDOWN },
+  { "TOTALHOSTSDOWNUNHANDLED",        MACRO_TOTALHOSTSDOWNUNHANDLED },
+  { "TOTALHOSTSERVICES",              MACRO_TOTALHOSTSERVICES },
+  { "TOTALHOSTSERVICESCRITICAL",      MACRO_TOTALHOSTSERVICESCRITICAL },
+  { "TOTALHOSTSERVICESOK",            MACRO_TOTALHOSTSERVICESOK },
+  { "TOTALHOSTSERVICESUNKNOWN",       MACRO_TOTALHOSTSERVICESUNKNOWN },
+  { "TOTALHOSTSERVICESWARNING",       MACRO_TOTALHOSTSERVICESWARNING },
+  { "TOTALHOSTSUNREACHABLE",          MACRO_TOTALHOSTSUNREACHABLE },
+  { "TOTALHOSTSUNREACHABLEUNHANDLED", MACRO_TOTALHOSTSUNREACHABLEUNHANDLED },
+  { "TOTALHOSTSUP",                   MACRO_TOTALHOSTSUP },
+  { "TOTALSERVICEPROBLEMS",           MACRO_TOTALSERVICEPROBLEMS },
+  { "TOTALSERVICEPROBLEMSUNHANDLED",  MACRO_TOTALSERVICEPROBLEMSUNHANDLED },
+  { "TOTALSERVICESCRITICAL",          MACRO_TOTALSERVICESCRITICAL },
+  { "TOTALSERVICESCRITICALUNHANDLED", MACRO_TOTALSERVICESCRITICALUNHANDLED },
+  { "TOTALSERVICESOK",                MACRO_TOTALSERVICESOK },
+  { "TOTALSERVICESUNKNOWN",           MACRO_TOTALSERVICESUNKNOWN },
+  { "TOTALSERVICESUNKNOWNUNHANDLED",  MACRO_TOTALSERVICESUNKNOWNUNHANDLED },
+  { "TOTALSERVICESWARNING",           MACRO_TOTALSERVICESWARNING },
+  { "TOTALSERVICESWARNINGUNHANDLED",  MACRO_TOTALSERVICESWARNINGUNHANDLED }
+};
+static unsigned int const macrox_table_size(
+  sizeof(macrox_table) / sizeof(*macrox_table));
+
+/**
+ *  Compare a macro table entry with a macro name.
+ *
+ *  @param[in] entry  Table entry.
+ *  @param[in] name   Macro name.
+ *
+ *  @return true if entry is strictly before name.
+ */
+static bool macrox_entry_less(macrox_entry const& entry, char const* name) {
+  return (strcmp(entry.name, name) < 0);
+}
+
+/**
+ *  Find the ID of a standard macro.
+ *
+ *  @param[in] name  Macro name, without the '$' delimiters nor any
+ *                   on-demand argument.
+ *
+ *  @return Macro ID, or -1 if name is not a standard macro.
+ */
+int macros::find_macrox(char const* name) {
+  if (!name)
+    return (-1);
+  macrox_entry const* end(macrox_table + macrox_table_size);
+  macrox_entry const* it(std::lower_bound(
+                           macrox_table,
+                           end,
+                           name,
+                           macrox_entry_less));
+  if ((it == end) || strcmp(it->name, name))
+    return (-1);
+  return (it->id);
+}
+
+/**
+ *  Get the cleaning options that a standard macro requires.
+ *
+ *  @param[in] macro_type  Macro ID.
+ *
+ *  @return Cleaning options of this macro.
+ */
+int macros::get_macrox_clean_options(unsigned int macro_type) {
+  int options(0);
+
+  // Host/service output/perfdata and author/comment macros
+  // should get cleaned.
+  if ((macro_type >= 16 && macro_type <= 19)
+      || (macro_type >= 49 && macro_type <= 52)
+      || (macro_type >= 99 && macro_type <= 100)
+      || (macro_type >= 124 && macro_type <= 127))
+    options |= (STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+
+  // URL macros should get cleaned.
+  if ((macro_type >= 125 && macro_type <= 126)
+      || (macro_type >= 128 && macro_type <= 129)
+      || (macro_type >= 77 && macro_type <= 78)
+      || (macro_type >= 74 && macro_type <= 75))
+    options |= URL_ENCODE_MACRO_CHARS;
+
+  return (options);
+}
@@ -0,0 +1,396 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/objects/contactgroup.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::macros;
+
+// Class instance.
+summary* summary::_instance(NULL);
+
+/**
+ *  Check if a host state is a problem for its services.
+ *
+ *  @param[in] hst  Host.
+ *
+ *  @return true if host is down or unreachable.
+ */
+static bool is_host_problem(host const* hst) {
+  return (hst
+          && ((hst->current_state == HOST_DOWN)
+              || (hst->current_state == HOST_UNREACHABLE)));
+}
+
+/**
+ *  Get service totals of a host.
+ *
+ *  @param[in] hst  Host.
+ *
+ *  @return Service totals of this host.
+ */
+summary::host_services const& summary::get_host_services(
+                                         host* hst) const {
+  umap<host*, host_services>::const_iterator it(_host_services.find(hst));
+  if (it == _host_services.end()) {
+    static host_services const empty = host_services();
+    return (empty);
+  }
+  return (it->second);
+}
+
+/**
+ *  Get totals.
+ *
+ *  @param[in] cntct  If not NULL, only count objects this contact is
+ *                    a contact for.
+ *
+ *  @return Host and service totals.
+ */
+summary::totals const& summary::get_totals(contact* cntct) const {
+  if (!cntct)
+    return (_totals);
+  umap<contact*, totals>::const_iterator it(_contact_totals.find(cntct));
+  if (it == _contact_totals.end()) {
+    static totals const empty = totals();
+    return (empty);
+  }
+  return (it->second);
+}
+
+/**
+ *  Get class instance.
+ *
+ *  @return Class instance.
+ */
+summary& summary::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void summary::load() {
+  if (!_instance)
+    _instance = new summary;
+  return ;
+}
+
+/**
+ *  Compute totals of all hosts and services again. Must be called
+ *  when objects were created or deleted.
+ */
+void summary::rebuild() {
+  _contact_totals.clear();
+  _host_services.clear();
+  _hosts.clear();
+  _services.clear();
+  memset(&_totals, 0, sizeof(_totals));
+  for (host* hst(host_list); hst; hst = hst->next)
+    update(hst);
+  for (service* svc(service_list); svc; svc = svc->next)
+    update(svc);
+  return ;
+}
+
+/**
+ *  Unload singleton.
+ */
+void summary::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Update totals after a host status change.
+ *
+ *  @param[in] hst  Host.
+ */
+void summary::update(host* hst) {
+  if (!hst)
+    return ;
+
+  state new_state(_get_state(*hst));
+  umap<host*, state>::iterator it(_hosts.find(hst));
+  state old_state((it != _hosts.end()) ? it->second : state_none);
+  if (it == _hosts.end())
+    _hosts.insert(std::make_pair(hst, new_state));
+  else if (old_state == new_state)
+    return ;
+  else
+    it->second = new_state;
+
+  std::set<contact*> contacts;
+  _get_contacts(hst->contacts, hst->contact_groups, contacts);
+  _move(old_state, new_state, contacts);
+
+  // Unhandled service problems depend on the host state.
+  bool old_problem((old_state >= state_host_down)
+                   && (old_state <= state_host_unreachable_unhandled));
+  if (old_problem != is_host_problem(hst))
+    for (servicesmember* member(hst->services);
+         member;
+         member = member->next)
+      update(member->service_ptr);
+  return ;
+}
+
+/**
+ *  Update totals after a service status change.
+ *
+ *  @param[in] svc  Service.
+ */
+void summary::update(service* svc) {
+  if (!svc)
+    return ;
+
+  state new_state(_get_state(*svc));
+  state old_state;
+  umap<service*, service_info>::iterator it(_services.find(svc));
+  if (it == _services.end()) {
+    service_info info;
+    info.summary_state = new_state;
+    info.current_state = svc->current_state;
+    _services.insert(std::make_pair(svc, info));
+    if (svc->host_ptr)
+      ++_host_services[svc->host_ptr].total;
+    _add_host_service(svc->host_ptr, svc->current_state, 1);
+    old_state = state_none;
+  }
+  else {
+    if (it->second.current_state != svc->current_state) {
+      _add_host_service(svc->host_ptr, it->second.current_state, -1);
+      _add_host_service(svc->host_ptr, svc->current_state, 1);
+      it->second.current_state = svc->current_state;
+    }
+    old_state = it->second.summary_state;
+    if (old_state == new_state)
+      return ;
+    it->second.summary_state = new_state;
+  }
+
+  std::set<contact*> contacts;
+  _get_contacts(svc->contacts, svc->contact_groups, contacts);
+  _move(old_state, new_state, contacts);
+  return ;
+}
+
+/**
+ *  Constructor.
+ */
+summary::summary() {
+  memset(&_totals, 0, sizeof(_totals));
+}
+
+/**
+ *  Destructor.
+ */
+summary::~summary() throw () {}
+
+/**
+ *  Add or remove an object of some state to totals.
+ *
+ *  @param[in,out] t      Totals.
+ *  @param[in]     s      Object state.
+ *  @param[in]     count  1 to add the object, -1 to remove it.
+ */
+void summary::_add(totals& t, state s, int count) {
+  switch (s) {
+  case state_none:
+    break ;
+  case state_host_up:
+    t.hosts_up += count;
+    break ;
+  case state_host_down_unhandled:
+    t.hosts_down_unhandled += count;
+    // Fall through.
+  case state_host_down:
+    t.hosts_down += count;
+    break ;
+  case state_host_unreachable_unhandled:
+    t.hosts_unreachable_unhandled += count;
+    // Fall through.
+  case state_host_unreachable:
+    t.hosts_unreachable += count;
+    break ;
+  case state_service_ok:
+    t.services_ok += count;
+    break ;
+  case state_service_warning_unhandled:
+    t.services_warning_unhandled += count;
+    // Fall through.
+  case state_service_warning:
+    t.services_warning += count;
+    break ;
+  case state_service_unknown_unhandled:
+    t.services_unknown_unhandled += count;
+    // Fall through.
+  case state_service_unknown:
+    t.services_unknown += count;
+    break ;
+  case state_service_critical_unhandled:
+    t.services_critical_unhandled += count;
+    // Fall through.
+  case state_service_critical:
+    t.services_critical += count;
+    break ;
+  }
+  return ;
+}
+
+/**
+ *  Add or remove a service of some state to the totals of its host.
+ *
+ *  @param[in] hst            Host of the service.
+ *  @param[in] current_state  Service state.
+ *  @param[in] count          1 to add the service, -1 to remove it.
+ */
+void summary::_add_host_service(
+                host* hst,
+                int current_state,
+                int count) {
+  if (!hst)
+    return ;
+  umap<host*, host_services>::iterator it(_host_services.find(hst));
+  if (it == _host_services.end())
+    it = _host_services.insert(
+           std::make_pair(hst, host_services())).first;
+  switch (current_state) {
+  case STATE_OK:
+    it->second.ok += count;
+    break ;
+  case STATE_WARNING:
+    it->second.warning += count;
+    break ;
+  case STATE_UNKNOWN:
+    it->second.unknown += count;
+    break ;
+  case STATE_CRITICAL:
+    it->second.critical += count;
+    break ;
+  }
+  return ;
+}
+
+/**
+ *  Get the summary state of a host.
+ *
+ *  @param[in] hst  Host.
+ *
+ *  @return Summary state.
+ */
+summary::state summary::_get_state(host const& hst) {
+  bool handled((hst.scheduled_downtime_depth > 0)
+               || hst.problem_has_been_acknowledged
+               || !hst.checks_enabled);
+  if ((hst.current_state == HOST_UP) && hst.has_been_checked)
+    return (state_host_up);
+  else if (hst.current_state == HOST_DOWN)
+    return (handled ? state_host_down : state_host_down_unhandled);
+  else if (hst.current_state == HOST_UNREACHABLE)
+    return (handled
+            ? state_host_unreachable
+            : state_host_unreachable_unhandled);
+  return (state_none);
+}
+
+/**
+ *  Get the summary state of a service.
+ *
+ *  @param[in] svc  Service.
+ *
+ *  @return Summary state.
+ */
+summary::state summary::_get_state(service const& svc) {
+  bool handled(is_host_problem(svc.host_ptr)
+               || (svc.scheduled_downtime_depth > 0)
+               || svc.problem_has_been_acknowledged
+               || !svc.checks_enabled);
+  if ((svc.current_state == STATE_OK) && svc.has_been_checked)
+    return (state_service_ok);
+  else if (svc.current_state == STATE_WARNING)
+    return (handled
+            ? state_service_warning
+            : state_service_warning_unhandled);
+  else if (svc.current_state == STATE_UNKNOWN)
+    return (handled
+            ? state_service_unknown
+            : state_service_unknown_unhandled);
+  else if (svc.current_state == STATE_CRITICAL)
+    return (handled
+            ? state_service_critical
+            : state_service_critical_unhandled);
+  return (state_none);
+}
+
+/**
+ *  Get all contacts of an object, including members of its contact
+ *  groups.
+ *
+ *  @param[in]  contacts  Contacts of the object.
+ *  @param[in]  groups    Contact groups of the object.
+ *  @param[out] result    Contacts.
+ */
+void summary::_get_contacts(
+                contactsmember* contacts,
+                contactgroupsmember* groups,
+                std::set<contact*>& result) {
+  for (contactsmember* member(contacts); member; member = member->next)
+    if (member->contact_ptr)
+      result.insert(member->contact_ptr);
+  for (contactgroupsmember* group(groups); group; group = group->next)
+    if (group->group_ptr)
+      for (contactsmember* member(group->group_ptr->members);
+           member;
+           member = member->next)
+        if (member->contact_ptr)
+          result.insert(member->contact_ptr);
+  return ;
+}
+
+/**
+ *  Move an object from a state to another in all totals.
+ *
+ *  @param[in] old_state  Previous state of the object.
+ *  @param[in] new_state  New state of the object.
+ *  @param[in] contacts   Contacts of the object.
+ */
+void summary::_move(
+                state old_state,
+                state new_state,
+                std::set<contact*> const& contacts) {
+  _add(_totals, old_state, -1);
+  _add(_totals, new_state, 1);
+  for (std::set<contact*>::const_iterator
+         it(contacts.begin()), end(contacts.end());
+       it != end;
+       ++it) {
+    umap<contact*, totals>::iterator t(_contact_totals.find(*it));
+    if (t == _contact_totals.end())
+      t = _contact_totals.insert(std::make_pair(*it, totals())).first;
+    _add(t->second, old_state, -1);
+    _add(t->second, new_state, 1);
+  }
+  return ;
+}
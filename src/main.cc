@@ -52,8 +52,11 @@
 #include "com/centreon/engine/logging/broker.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/nebmods.hh"
 #include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
 #include "com/centreon/engine/objects/comment.hh"
 #include "com/centreon/engine/objects/downtime.hh"
 #include "com/centreon/engine/perfdata.hh"
@@ -113,8 +116,11 @@ int main(int argc, char* argv[]) {
   config = new configuration::state;
   com::centreon::engine::timezone_manager::load();
   com::centreon::engine::commands::set::load();
+  com::centreon::engine::macros::summary::load();
   com::centreon::engine::configuration::applier::state::load();
   com::centreon::engine::checks::checker::load();
+  com::centreon::engine::notifications::dispatcher::load();
+  com::centreon::engine::notifications::digest::load();
   com::centreon::engine::events::loop::load();
   com::centreon::engine::broker::loader::load();
   com::centreon::engine::broker::compatibility::load();
@@ -409,6 +415,10 @@ int main(int argc, char* argv[]) {
         // restart or shutdown signal is encountered).
         com::centreon::engine::events::loop::instance().run();
 
+        // Send pending digests and wait for notification commands.
+        com::centreon::engine::notifications::digest::instance().flush_all();
+        com::centreon::engine::notifications::dispatcher::instance().wait();
+
         if (sigshutdown)
           logger(logging::log_process_info, logging::basic)
             << "Caught SIG" << sigs[sig_id] << ", shutting down ...";
@@ -464,10 +474,13 @@ int main(int argc, char* argv[]) {
   }
 
   // Unload singletons and global objects.
+  com::centreon::engine::notifications::digest::unload();
+  com::centreon::engine::notifications::dispatcher::unload();
   com::centreon::engine::events::loop::unload();
   com::centreon::engine::broker::compatibility::unload();
   com::centreon::engine::broker::loader::unload();
   com::centreon::engine::configuration::applier::state::unload();
+  com::centreon::engine::macros::summary::unload();
   com::centreon::engine::commands::set::unload();
   com::centreon::engine::checks::checker::unload();
   delete config;
@@ -19,6 +19,7 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <string>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/globals.hh"
@@ -26,18 +27,29 @@
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
 #include "com/centreon/engine/shared.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timeperiod.hh"
 #include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/engine/utils.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration::applier;
 using namespace com::centreon::engine::logging;
 
+// Entries of notification_list indexed by contact, and the value of
+// $NOTIFICATIONRECIPIENTS$ for that list. They are cleared along with
+// notification_list, by free_notification_list().
+static umap<contact*, notification*> notification_recipients;
+static std::string                   notification_recipients_macro;
+
+static int add_recipient(contact* cntct);
+
 static char const* tab_notification_str[] = {
   "NORMAL",
   "ACKNOWLEDGEMENT",
@@ -61,6 +73,29 @@ static char const* tab_service_state_str[] = {
   "CRITICAL"
 };
 
+/**
+ *  Build the state of a notification as written in the log file,
+ *  like "CRITICAL" or "ACKNOWLEDGEMENT (CRITICAL)".
+ *
+ *  @param[in] mac        Macros of the notification.
+ *  @param[in] type       Notification type.
+ *  @param[in] state_str  State of the notified object.
+ *
+ *  @return Notification state.
+ */
+static std::string notification_state(
+                     nagios_macros const* mac,
+                     int type,
+                     char const* state_str) {
+  std::string retval;
+  if ((type == NOTIFICATION_NORMAL) || !mac->x[MACRO_NOTIFICATIONTYPE])
+    retval = state_str;
+  else
+    retval.append(mac->x[MACRO_NOTIFICATIONTYPE])
+      .append(" (").append(state_str).append(")");
+  return (retval);
+}
+
 /******************************************************************/
 /***************** SERVICE NOTIFICATION FUNCTIONS *****************/
 /******************************************************************/
@@ -883,8 +918,6 @@ int notify_contact_of_service(
   char* command_name_ptr = NULL;
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime;
   struct timeval start_time, end_time;
   struct timeval method_start_time, method_end_time;
   int macro_options = STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS;
@@ -932,8 +965,37 @@ int notify_contact_of_service(
   else if (NEBERROR_CALLBACKOVERRIDE == neb_result)
     return (OK);
 
+  /* coalesce the notification in the digest of the contact */
+  bool digested(false);
+  {
+    char const* service_state_str("UNKNOWN");
+    if ((unsigned int)svc->current_state < sizeof(tab_service_state_str) / sizeof(*tab_service_state_str))
+      service_state_str = tab_service_state_str[svc->current_state];
+    std::string state(notification_state(mac, type, service_state_str));
+    std::string item;
+    item.append(mac->x[MACRO_NOTIFICATIONTYPE]
+                ? mac->x[MACRO_NOTIFICATIONTYPE]
+                : "").append(";")
+      .append(svc->host_name).append(";")
+      .append(svc->description).append(";")
+      .append(service_state_str).append(";")
+      .append(svc->plugin_output ? svc->plugin_output : "");
+    digested = notifications::digest::instance().push(
+                 cntct,
+                 SERVICE_NOTIFICATION,
+                 item);
+    if (digested && config->log_notifications())
+      logger(log_service_notification, basic)
+        << "SERVICE NOTIFICATION: " << cntct->name << ';'
+        << svc->host_name << ';' << svc->description << ';'
+        << state << ";DIGEST;"
+        << (svc->plugin_output ? svc->plugin_output : "");
+  }
+
   /* process all the notification commands this user has */
-  for (temp_commandsmember = cntct->service_notification_commands;
+  for (temp_commandsmember = (digested
+                              ? NULL
+                              : cntct->service_notification_commands);
        temp_commandsmember != NULL;
        temp_commandsmember = temp_commandsmember->next) {
 
@@ -1037,29 +1099,18 @@ int notify_contact_of_service(
 
     /* run the notification command */
     try {
-      my_system_r(
-        mac,
+      notifications::dispatcher::instance().run(
+        *mac,
         processed_command,
         config->notification_timeout(),
-        &early_timeout,
-        &exectime,
-        NULL,
-        0);
+        cntct->name,
+        SERVICE_NOTIFICATION);
     } catch (std::exception const& e) {
       logger(log_runtime_error, basic)
         << "Error: can't execute service notification '"
         << cntct->name << "' : " << e.what();
     }
 
-    /* check to see if the notification command timed out */
-    if (early_timeout == true) {
-      logger(log_service_notification | log_runtime_warning, basic)
-        << "Warning: Contact '" << cntct->name
-        << "' service notification command '" << processed_command
-        << "' timed out after " << config->notification_timeout()
-        << " seconds";
-    }
-
     /* free memory */
     delete[] command_name;
     delete[] raw_command;
@@ -1188,24 +1239,16 @@ int should_service_notification_be_escalated(service* svc) {
     << "should_service_notification_be_escalated()";
 
   // Browse service escalations related to this service.
-  typedef umultimap<std::pair<std::string, std::string>, shared_ptr<serviceescalation> > collection;
-  std::pair<collection::iterator, collection::iterator> p;
-  p = state::instance().serviceescalations().equal_range(
-        std::make_pair(svc->host_name, svc->description));
-  while (p.first != p.second) {
-    serviceescalation* temp_se(p.first->second.get());
-
+  for (serviceescalation** se(svc->escalations_ptr); se && *se; ++se) {
     // We found a matching entry, so escalate this notification!
     if (is_valid_escalation_for_service_notification(
           svc,
-          temp_se,
+          *se,
           NOTIFICATION_OPTION_NONE) == true) {
       logger(dbg_notifications, more)
         << "Service notification WILL be escalated.";
       return (true);
     }
-
-    ++p.first;
   }
   logger(dbg_notifications, more)
     << "Service notification will NOT be escalated.";
@@ -1251,15 +1294,8 @@ int create_notification_list_from_service(
       << "Adding contacts from service escalation(s) to "
       "notification list.";
 
-    std::pair<std::string, std::string>
-      id(std::make_pair(svc->host_name, svc->description));
-    umultimap<std::pair<std::string, std::string>, shared_ptr<serviceescalation> > const&
-      escalations(state::instance().serviceescalations());
-    for (umultimap<std::pair<std::string, std::string>, shared_ptr<serviceescalation> >::const_iterator
-           it(escalations.find(id)), end(escalations.end());
-         it != end && it->first == id;
-         ++it) {
-      serviceescalation* temp_se(&*it->second);
+    for (serviceescalation** se(svc->escalations_ptr); se && *se; ++se) {
+      serviceescalation* temp_se(*se);
 
       /* skip this entry if it isn't appropriate */
       if (is_valid_escalation_for_service_notification(
@@ -1278,7 +1314,7 @@ int create_notification_list_from_service(
            temp_contactsmember = temp_contactsmember->next) {
         if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
           continue;
-        add_notification(mac, temp_contact);
+        add_recipient(temp_contact);
       }
 
       logger(dbg_notifications, most)
@@ -1301,7 +1337,7 @@ int create_notification_list_from_service(
              temp_contactsmember = temp_contactsmember->next) {
           if (!(temp_contact = temp_contactsmember->contact_ptr))
             continue;
-          add_notification(mac, temp_contact);
+          add_recipient(temp_contact);
         }
       }
     }
@@ -1320,7 +1356,7 @@ int create_notification_list_from_service(
          temp_contactsmember = temp_contactsmember->next) {
       if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
         continue;
-      add_notification(mac, temp_contact);
+      add_recipient(temp_contact);
     }
 
     /* add all contacts that belong to contactgroups for this service */
@@ -1339,11 +1375,16 @@ int create_notification_list_from_service(
            temp_contactsmember = temp_contactsmember->next) {
         if (!(temp_contact = temp_contactsmember->contact_ptr))
           continue;
-        add_notification(mac, temp_contact);
+        add_recipient(temp_contact);
       }
     }
   }
 
+  /* set the notification recipients macro */
+  string::setstr(
+    mac->x[MACRO_NOTIFICATIONRECIPIENTS],
+    notification_recipients_macro);
+
   return (OK);
 }
 
@@ -2081,8 +2122,6 @@ int notify_contact_of_host(
   char* command_name_ptr = NULL;
   char* raw_command = NULL;
   char* processed_command = NULL;
-  int early_timeout = false;
-  double exectime;
   struct timeval start_time;
   struct timeval end_time;
   struct timeval method_start_time;
@@ -2132,8 +2171,35 @@ int notify_contact_of_host(
   else if (NEBERROR_CALLBACKOVERRIDE == neb_result)
     return (OK);
 
+  /* coalesce the notification in the digest of the contact */
+  bool digested(false);
+  {
+    char const* host_state_str("UP");
+    if ((unsigned int)hst->current_state < sizeof(tab_host_state_str) / sizeof(*tab_host_state_str))
+      host_state_str = tab_host_state_str[hst->current_state];
+    std::string state(notification_state(mac, type, host_state_str));
+    std::string item;
+    item.append(mac->x[MACRO_NOTIFICATIONTYPE]
+                ? mac->x[MACRO_NOTIFICATIONTYPE]
+                : "").append(";")
+      .append(hst->name).append(";")
+      .append(host_state_str).append(";")
+      .append(hst->plugin_output ? hst->plugin_output : "");
+    digested = notifications::digest::instance().push(
+                 cntct,
+                 HOST_NOTIFICATION,
+                 item);
+    if (digested && config->log_notifications())
+      logger(log_host_notification, basic)
+        << "HOST NOTIFICATION: " << cntct->name << ';'
+        << hst->name << ';' << state << ";DIGEST;"
+        << (hst->plugin_output ? hst->plugin_output : "");
+  }
+
   /* process all the notification commands this user has */
-  for (temp_commandsmember = cntct->host_notification_commands;
+  for (temp_commandsmember = (digested
+                              ? NULL
+                              : cntct->host_notification_commands);
        temp_commandsmember != NULL;
        temp_commandsmember = temp_commandsmember->next) {
 
@@ -2236,29 +2302,18 @@ int notify_contact_of_host(
 
     /* run the notification command */
     try {
-      my_system_r(
-        mac,
+      notifications::dispatcher::instance().run(
+        *mac,
         processed_command,
         config->notification_timeout(),
-        &early_timeout,
-        &exectime,
-        NULL,
-        0);
+        cntct->name,
+        HOST_NOTIFICATION);
     } catch (std::exception const& e) {
       logger(log_runtime_error, basic)
         << "Error: can't execute host notification '"
         << cntct->name << "' : " << e.what();
     }
 
-    /* check to see if the notification timed out */
-    if (early_timeout == true) {
-      logger(log_host_notification | log_runtime_warning, basic)
-        << "Warning: Contact '" << cntct->name
-        << "' host notification command '" << processed_command
-        << "' timed out after " << config->notification_timeout()
-        << " seconds";
-    }
-
     /* free memory */
     delete[] command_name;
     delete[] raw_command;
@@ -2379,14 +2434,8 @@ int should_host_notification_be_escalated(host* hst) {
   if (hst == NULL)
     return (false);
 
-  std::string id(hst->name);
-  umultimap<std::string, shared_ptr<hostescalation> > const&
-    escalations(state::instance().hostescalations());
-  for (umultimap<std::string, shared_ptr<hostescalation> >::const_iterator
-         it(escalations.find(id)), end(escalations.end());
-       it != end && it->first == id;
-       ++it) {
-    hostescalation* temp_he(&*it->second);
+  for (hostescalation** he(hst->escalations_ptr); he && *he; ++he) {
+    hostescalation* temp_he(*he);
 
     /* we found a matching entry, so escalate this notification! */
     if (is_valid_escalation_for_host_notification(
@@ -2442,14 +2491,8 @@ int create_notification_list_from_host(
       << "Adding contacts from host escalation(s) to "
       "notification list.";
 
-    std::string id(hst->name);
-    umultimap<std::string, shared_ptr<hostescalation> > const&
-      escalations(state::instance().hostescalations());
-    for (umultimap<std::string, shared_ptr<hostescalation> >::const_iterator
-           it(escalations.find(id)), end(escalations.end());
-         it != end && it->first == id;
-         ++it) {
-      hostescalation* temp_he(&*it->second);
+    for (hostescalation** he(hst->escalations_ptr); he && *he; ++he) {
+      hostescalation* temp_he(*he);
 
       /* see if this escalation if valid for this notification */
       if (is_valid_escalation_for_host_notification(
@@ -2468,7 +2511,7 @@ int create_notification_list_from_host(
            temp_contactsmember = temp_contactsmember->next) {
         if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
           continue;
-        add_notification(mac, temp_contact);
+        add_recipient(temp_contact);
       }
 
       logger(dbg_notifications, most)
@@ -2491,7 +2534,7 @@ int create_notification_list_from_host(
              temp_contactsmember = temp_contactsmember->next) {
           if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
             continue;
-          add_notification(mac, temp_contact);
+          add_recipient(temp_contact);
         }
       }
     }
@@ -2513,7 +2556,7 @@ int create_notification_list_from_host(
          temp_contactsmember = temp_contactsmember->next) {
       if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
         continue;
-      add_notification(mac, temp_contact);
+      add_recipient(temp_contact);
     }
 
     logger(dbg_notifications, most)
@@ -2536,11 +2579,16 @@ int create_notification_list_from_host(
            temp_contactsmember = temp_contactsmember->next) {
         if ((temp_contact = temp_contactsmember->contact_ptr) == NULL)
           continue;
-        add_notification(mac, temp_contact);
+        add_recipient(temp_contact);
       }
     }
   }
 
+  /* set the notification recipients macro */
+  string::setstr(
+    mac->x[MACRO_NOTIFICATIONRECIPIENTS],
+    notification_recipients_macro);
+
   return (OK);
 }
 
@@ -2693,25 +2741,20 @@ notification* find_notification(contact* cntct) {
   logger(dbg_functions, basic)
     << "find_notification()";
 
-  if (cntct == NULL)
+  if (cntct == NULL || notification_list == NULL)
     return (NULL);
 
-  for (notification* temp_notification = notification_list;
-       temp_notification != NULL;
-       temp_notification = temp_notification->next) {
-    if (temp_notification->cntct == cntct)
-      return (temp_notification);
-  }
+  umap<contact*, notification*>::const_iterator
+    it(notification_recipients.find(cntct));
+  if (it != notification_recipients.end())
+    return (it->second);
 
   /* we couldn't find the contact in the notification list */
   return (NULL);
 }
 
-/* add a new notification to the list in memory */
-int add_notification(nagios_macros* mac, contact* cntct) {
-  logger(dbg_functions, basic)
-    << "add_notification()";
-
+/* add a new notification to the list in memory, without updating the recipients macro */
+static int add_recipient(contact* cntct) {
   if (cntct == NULL)
     return (ERROR);
 
@@ -2732,15 +2775,47 @@ int add_notification(nagios_macros* mac, contact* cntct) {
   new_notification->next = notification_list;
   notification_list = new_notification;
 
-  /* add contact to notification recipients macro */
-  if (!mac->x[MACRO_NOTIFICATIONRECIPIENTS])
-    string::setstr(mac->x[MACRO_NOTIFICATIONRECIPIENTS], cntct->name);
-  else {
-    std::string buffer(mac->x[MACRO_NOTIFICATIONRECIPIENTS]);
-    buffer += ",";
-    buffer += cntct->name;
-    string::setstr(mac->x[MACRO_NOTIFICATIONRECIPIENTS], buffer);
-  }
+  notification_recipients[cntct] = new_notification;
+
+  /* add contact to notification recipients */
+  if (!notification_recipients_macro.empty())
+    notification_recipients_macro.push_back(',');
+  notification_recipients_macro.append(cntct->name);
 
   return (OK);
 }
+
+/* add a new notification to the list in memory */
+int add_notification(nagios_macros* mac, contact* cntct) {
+  logger(dbg_functions, basic)
+    << "add_notification()";
+
+  if (add_recipient(cntct) != OK)
+    return (ERROR);
+
+  /* update notification recipients macro */
+  string::setstr(
+    mac->x[MACRO_NOTIFICATIONRECIPIENTS],
+    notification_recipients_macro);
+
+  return (OK);
+}
+
+/* free a notification list that was created */
+void free_notification_list() {
+  notification* temp_notification = NULL;
+  notification* next_notification = NULL;
+
+  temp_notification = notification_list;
+  while (temp_notification != NULL) {
+    next_notification = temp_notification->next;
+    delete temp_notification;
+    temp_notification = next_notification;
+  }
+
+  /* reset notification list pointer and its index */
+  notification_list = NULL;
+  notification_recipients.clear();
+  notification_recipients_macro.clear();
+  return;
+}
@@ -0,0 +1,272 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <exception>
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
+#include "com/centreon/engine/string.hh"
+#include "com/centreon/engine/timezone_locker.hh"
+#include "com/centreon/engine/utils.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::notifications;
+
+// Class instance.
+static digest* _instance(NULL);
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Send the batches whose interval is elapsed.
+ *
+ *  @param[in] now  Current time.
+ */
+void digest::flush(time_t now) {
+  if (_batches.empty() || (now < _next_deadline))
+    return ;
+
+  // Batches are sent after being removed, so that notifications
+  // pushed while sending open new batches.
+  std::vector<std::pair<std::string, batch> > elapsed;
+  _next_deadline = 0;
+  for (umap<std::string, batch>::iterator
+         it(_batches.begin()), end(_batches.end());
+       it != end;) {
+    if (it->second.deadline <= now) {
+      elapsed.push_back(*it);
+      _batches.erase(it++);
+    }
+    else {
+      if (!_next_deadline || (it->second.deadline < _next_deadline))
+        _next_deadline = it->second.deadline;
+      ++it;
+    }
+  }
+  for (std::vector<std::pair<std::string, batch> >::const_iterator
+         it(elapsed.begin()), end(elapsed.end());
+       it != end;
+       ++it)
+    _send(it->first, it->second);
+  return ;
+}
+
+/**
+ *  Send all batches, whether their interval is elapsed or not.
+ */
+void digest::flush_all() {
+  umap<std::string, batch> batches;
+  batches.swap(_batches);
+  _next_deadline = 0;
+  for (umap<std::string, batch>::const_iterator
+         it(batches.begin()), end(batches.end());
+       it != end;
+       ++it)
+    _send(it->first, it->second);
+  return ;
+}
+
+/**
+ *  Get instance of the digest singleton.
+ *
+ *  @return This singleton.
+ */
+digest& digest::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void digest::load() {
+  if (!_instance)
+    _instance = new digest;
+  return ;
+}
+
+/**
+ *  Add a notification to the batch of a contact.
+ *
+ *  @param[in] cntct              Notified contact.
+ *  @param[in] notification_type  HOST_NOTIFICATION or
+ *                                SERVICE_NOTIFICATION.
+ *  @param[in] item               Summary of the notification.
+ *
+ *  @return False if the contact has no digest, in which case the
+ *          notification must be sent immediately.
+ */
+bool digest::push(
+               contact* cntct,
+               int notification_type,
+               std::string const& item) {
+  std::map<std::string, contact_other_properties>::const_iterator
+    props(contact_other_props.find(cntct->name));
+  if ((props == contact_other_props.end())
+      || !props->second.notification_digest_interval)
+    return (false);
+
+  umap<std::string, batch>::iterator it(_batches.find(cntct->name));
+  if (it == _batches.end()) {
+    batch b;
+    b.deadline = time(NULL)
+      + props->second.notification_digest_interval
+        * config->interval_length();
+    it = _batches.insert(std::make_pair(cntct->name, b)).first;
+    if (!_next_deadline || (b.deadline < _next_deadline))
+      _next_deadline = b.deadline;
+  }
+  it->second.items[notification_type].push_back(item);
+
+  logger(dbg_notifications, most)
+    << "Notification added to the digest of contact '"
+    << cntct->name << "' (" << it->second.items[notification_type].size()
+    << " pending)";
+  return (true);
+}
+
+/**
+ *  Unload singleton.
+ */
+void digest::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Default constructor.
+ */
+digest::digest() : _next_deadline(0) {}
+
+/**
+ *  Destructor.
+ */
+digest::~digest() throw () {}
+
+/**
+ *  Run the notification commands of a contact for a batch.
+ *
+ *  @param[in] contact_name  Contact name.
+ *  @param[in] b             Batch of notifications.
+ */
+void digest::_send(std::string const& contact_name, batch const& b) {
+  umap<std::string, shared_ptr<contact_struct> >::const_iterator
+    it(configuration::applier::state::instance().contacts().find(
+         contact_name));
+  if (it == configuration::applier::state::instance().contacts().end()) {
+    logger(log_runtime_warning, basic)
+      << "Warning: Notification digest of contact '" << contact_name
+      << "' dropped: contact does not exist anymore";
+    return ;
+  }
+  contact* cntct(it->second.get());
+  timezone_locker lock(get_contact_timezone(cntct->name));
+  int macro_options(STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+
+  for (int type(HOST_NOTIFICATION); type <= SERVICE_NOTIFICATION; ++type) {
+    std::vector<std::string> const& items(b.items[type]);
+    if (items.empty())
+      continue ;
+
+    nagios_macros mac;
+    memset(&mac, 0, sizeof(mac));
+    grab_contact_macros_r(&mac, cntct);
+    // Notification commands are processed with illegal characters
+    // stripped, which would remove newlines. Like long plugin output,
+    // lines are separated by an escaped newline instead.
+    std::string payload;
+    for (std::vector<std::string>::const_iterator
+           it(items.begin()), end(items.end());
+         it != end;
+         ++it) {
+      if (it != items.begin())
+        payload.append("\\n");
+      char* escaped(escape_newlines(const_cast<char*>(it->c_str())));
+      payload.append(escaped);
+      delete[] escaped;
+    }
+    string::setstr(mac.x[MACRO_NOTIFICATIONTYPE], "DIGEST");
+    string::setstr(mac.x[MACRO_NOTIFICATIONDIGEST], payload);
+    string::setstr(mac.x[MACRO_NOTIFICATIONDIGESTCOUNT], items.size());
+
+    logger(dbg_notifications, basic)
+      << "Sending digest of " << items.size() << ' '
+      << (type == HOST_NOTIFICATION ? "host" : "service")
+      << " notifications to contact '" << cntct->name << "'";
+
+    for (commandsmember* cmd(type == HOST_NOTIFICATION
+                             ? cntct->host_notification_commands
+                             : cntct->service_notification_commands);
+         cmd;
+         cmd = cmd->next) {
+      char* raw_command(NULL);
+      get_raw_command_line_r(
+        &mac,
+        cmd->command_ptr,
+        cmd->cmd,
+        &raw_command,
+        macro_options);
+      if (!raw_command)
+        continue ;
+      char* processed_command(NULL);
+      process_macros_r(
+        &mac,
+        raw_command,
+        &processed_command,
+        macro_options);
+      delete[] raw_command;
+      if (!processed_command)
+        continue ;
+
+      try {
+        dispatcher::instance().run(
+          mac,
+          processed_command,
+          config->notification_timeout(),
+          cntct->name,
+          type);
+      }
+      catch (std::exception const& e) {
+        logger(log_runtime_error, basic)
+          << "Error: can't execute notification digest of contact '"
+          << cntct->name << "' : " << e.what();
+      }
+      delete[] processed_command;
+    }
+    clear_volatile_macros_r(&mac);
+  }
+  return ;
+}
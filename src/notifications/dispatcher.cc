@@ -0,0 +1,414 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <exception>
+#include <sys/time.h>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/commands/raw.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::notifications;
+
+// Class instance.
+static dispatcher* _instance(NULL);
+
+/**************************************
+*                                     *
+*           Public Methods            *
+*                                     *
+**************************************/
+
+/**
+ *  Set the number of workers and the maximum queue depth. Changing
+ *  the number of workers waits for queued commands to be run, so this
+ *  is only done when the configuration is applied, not when commands
+ *  are submitted. Must be called from the main thread.
+ *
+ *  @param[in] workers     Number of workers, 0 runs commands
+ *                         synchronously.
+ *  @param[in] queue_size  Maximum number of queued commands.
+ */
+void dispatcher::configure(
+                   unsigned int workers,
+                   unsigned int queue_size) {
+  {
+    concurrency::locker lock(&_lock);
+    _queue_size = queue_size;
+    _slot.wake_all();
+  }
+  if (_workers.size() != workers) {
+    _stop_workers();
+    reap();
+    _start_workers(workers);
+  }
+  return ;
+}
+
+/**
+ *  Get instance of the dispatcher singleton.
+ *
+ *  @return This singleton.
+ */
+dispatcher& dispatcher::instance() {
+  return (*_instance);
+}
+
+/**
+ *  Load singleton.
+ */
+void dispatcher::load() {
+  if (!_instance)
+    _instance = new dispatcher;
+  return ;
+}
+
+/**
+ *  Send the results of the finished notification commands to the
+ *  event broker. Must be called from the main thread.
+ */
+void dispatcher::reap() {
+  std::deque<job*> done;
+  {
+    concurrency::locker lock(&_lock);
+    if (_done.empty())
+      return ;
+    done.swap(_done);
+  }
+  for (std::deque<job*>::iterator it(done.begin()), end(done.end());
+       it != end;
+       ++it) {
+    _finish(**it);
+    delete *it;
+  }
+  return ;
+}
+
+/**
+ *  Run a notification command. The environment of the command is
+ *  built from macros before the command is queued, so macros can be
+ *  reused as soon as this method returns. The system command start
+ *  event is sent to the event broker right away, the end event is sent
+ *  when the result is reaped.
+ *
+ *  @param[in,out] mac                Macros of the notification.
+ *  @param[in]     cmd                Processed command line.
+ *  @param[in]     timeout            Command timeout.
+ *  @param[in]     contact_name       Name of the notified contact.
+ *  @param[in]     notification_type  HOST_NOTIFICATION or
+ *                                    SERVICE_NOTIFICATION.
+ */
+void dispatcher::run(
+                   nagios_macros& mac,
+                   std::string const& cmd,
+                   unsigned int timeout,
+                   std::string const& contact_name,
+                   int notification_type) {
+  job* j(new job);
+  j->command = cmd;
+  j->contact_name = contact_name;
+  j->notification_type = notification_type;
+  j->timeout = timeout;
+  try {
+    commands::raw::build_environment(mac, j->env);
+  }
+  catch (...) {
+    delete j;
+    throw;
+  }
+
+  // Send event broker.
+  gettimeofday(&j->start_time, NULL);
+  timeval no_time = timeval();
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_START,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j->start_time,
+    no_time,
+    0.0,
+    j->timeout,
+    false,
+    STATE_OK,
+    const_cast<char*>(j->command.c_str()),
+    NULL,
+    NULL);
+
+  // Without workers, commands are run synchronously.
+  if (_workers.empty()) {
+    ++_dispatched;
+    _execute(*j);
+    _finish(*j);
+    delete j;
+    return ;
+  }
+
+  concurrency::locker lock(&_lock);
+  if (_queue.size() >= _queue_size) {
+    ++_blocked;
+    logger(dbg_notifications, more)
+      << "Notification queue is full (" << _queue.size()
+      << " commands), waiting for a free slot";
+    while (_queue.size() >= _queue_size)
+      _slot.wait(&_lock);
+  }
+  _queue.push_back(j);
+  ++_dispatched;
+  if (_queue.size() > _max_depth)
+    _max_depth = _queue.size();
+  _pending.wake_one();
+  return ;
+}
+
+/**
+ *  Unload singleton.
+ */
+void dispatcher::unload() {
+  delete _instance;
+  _instance = NULL;
+  return ;
+}
+
+/**
+ *  Wait for all queued notification commands to be finished and
+ *  reap their results. Must be called from the main thread.
+ */
+void dispatcher::wait() {
+  {
+    concurrency::locker lock(&_lock);
+    while (!_queue.empty() || _running)
+      _idle.wait(&_lock);
+  }
+  reap();
+  return ;
+}
+
+/**************************************
+*                                     *
+*           Private Methods           *
+*                                     *
+**************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] owner  Dispatcher to work for.
+ */
+dispatcher::worker::worker(dispatcher& owner)
+  : _owner(owner) {}
+
+/**
+ *  Destructor.
+ */
+dispatcher::worker::~worker() throw () {}
+
+/**
+ *  Thread entry point.
+ */
+void dispatcher::worker::_run() {
+  _owner._work();
+  return ;
+}
+
+/**
+ *  Default constructor.
+ */
+dispatcher::dispatcher()
+  : _blocked(0),
+    _dispatched(0),
+    _max_depth(0),
+    _queue_size(1),
+    _running(0),
+    _stopping(false),
+    _timed_out(0) {}
+
+/**
+ *  Destructor. Queued commands are run before workers exit.
+ */
+dispatcher::~dispatcher() throw () {
+  try {
+    _stop_workers();
+    reap();
+  }
+  catch (std::exception const& e) {
+    logger(log_runtime_error, basic)
+      << "Error: notification dispatcher destructor failed: "
+      << e.what();
+  }
+}
+
+/**
+ *  Run a notification command. This method does not access any
+ *  global object and can be called from any thread.
+ *
+ *  @param[in,out] j  Job to run.
+ */
+void dispatcher::_execute(job& j) {
+  try {
+    commands::raw raw_cmd("system", j.command);
+    raw_cmd.run(j.command, j.env, j.timeout, j.res);
+  }
+  catch (std::exception const& e) {
+    j.error = e.what();
+  }
+  return ;
+}
+
+/**
+ *  Send the result of a notification command to the event broker.
+ *
+ *  @param[in] j  Finished job.
+ */
+void dispatcher::_finish(job& j) {
+  bool host(j.notification_type == HOST_NOTIFICATION);
+  if (!j.error.empty()) {
+    logger(log_runtime_error, basic)
+      << "Error: can't execute "
+      << (host ? "host" : "service") << " notification '"
+      << j.contact_name << "' : " << j.error;
+    return ;
+  }
+
+  timeval end_time;
+  end_time.tv_sec = j.res.end_time.to_seconds();
+  end_time.tv_usec
+    = j.res.end_time.to_useconds() - end_time.tv_sec * 1000000ull;
+  double exectime((j.res.end_time - j.res.start_time).to_seconds());
+  int early_timeout(j.res.exit_status == process::timeout);
+
+  logger(dbg_commands, more)
+    << com::centreon::logging::setprecision(3)
+    << "Execution time=" << exectime
+    << " sec, early timeout=" << early_timeout
+    << ", result=" << j.res.exit_code;
+
+  // Send event broker.
+  broker_system_command(
+    NEBTYPE_SYSTEM_COMMAND_END,
+    NEBFLAG_NONE,
+    NEBATTR_NONE,
+    j.start_time,
+    end_time,
+    exectime,
+    j.timeout,
+    early_timeout,
+    j.res.exit_code,
+    const_cast<char*>(j.command.c_str()),
+    NULL,
+    NULL);
+
+  // Check to see if the notification command timed out.
+  if (early_timeout) {
+    ++_timed_out;
+    logger(
+      (host ? log_host_notification : log_service_notification)
+      | log_runtime_warning,
+      basic)
+      << "Warning: Contact '" << j.contact_name
+      << "' " << (host ? "host" : "service")
+      << " notification command '" << j.command
+      << "' timed out after " << j.timeout << " seconds";
+  }
+  return ;
+}
+
+/**
+ *  Log dispatcher statistics.
+ */
+void dispatcher::_log_stats() const {
+  if (_dispatched)
+    logger(log_info_message, basic)
+      << "Notification dispatcher: " << _dispatched
+      << " commands run, " << _timed_out << " timed out, maximum queue "
+      "depth " << _max_depth << ", queue full " << _blocked << " times";
+  return ;
+}
+
+/**
+ *  Start workers.
+ *
+ *  @param[in] count  Number of workers.
+ */
+void dispatcher::_start_workers(unsigned int count) {
+  _workers.reserve(count);
+  for (unsigned int i(0); i < count; ++i) {
+    _workers.push_back(new worker(*this));
+    _workers.back()->exec();
+  }
+  return ;
+}
+
+/**
+ *  Stop workers once all queued commands are run.
+ */
+void dispatcher::_stop_workers() {
+  if (_workers.empty())
+    return ;
+  {
+    concurrency::locker lock(&_lock);
+    _stopping = true;
+    _pending.wake_all();
+  }
+  for (std::vector<worker*>::iterator
+         it(_workers.begin()), end(_workers.end());
+       it != end;
+       ++it) {
+    (*it)->wait();
+    delete *it;
+  }
+  _workers.clear();
+  _stopping = false;
+  _log_stats();
+  return ;
+}
+
+/**
+ *  Worker loop: run queued commands until workers are stopped and the
+ *  queue is empty.
+ */
+void dispatcher::_work() {
+  concurrency::locker lock(&_lock);
+  while (true) {
+    while (_queue.empty() && !_stopping)
+      _pending.wait(&_lock);
+    if (_queue.empty())
+      break ;
+    job* j(_queue.front());
+    _queue.pop_front();
+    ++_running;
+    _slot.wake_one();
+
+    lock.unlock();
+    _execute(*j);
+    lock.relock();
+
+    _done.push_back(j);
+    --_running;
+    if (_queue.empty() && !_running)
+      _idle.wake_all();
+  }
+  return ;
+}
@@ -189,8 +189,8 @@ hostdependency* add_host_dependency(
 
   try {
     // Duplicate vars.
-    obj->dependent_host_name = string::dup(dependent_host_name);
-    obj->host_name = string::dup(host_name);
+    obj->dependent_host_name = string::intern(dependent_host_name);
+    obj->host_name = string::intern(host_name);
     if (dependency_period)
       obj->dependency_period = string::dup(dependency_period);
     obj->dependency_type = (dependency_type == EXECUTION_DEPENDENCY ? EXECUTION_DEPENDENCY : NOTIFICATION_DEPENDENCY);
@@ -198,6 +198,14 @@ hostdependency* add_host_dependency(
     obj->fail_on_pending = (fail_on_pending == 1);
     obj->fail_on_unreachable = (fail_on_unreachable == 1);
     obj->fail_on_up = (fail_on_up == 1);
+    if (obj->fail_on_up)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(HOST_UP);
+    if (obj->fail_on_down)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(HOST_DOWN);
+    if (obj->fail_on_unreachable)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(HOST_UNREACHABLE);
+    if (obj->fail_on_pending)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_PENDING;
     obj->inherits_parent = (inherits_parent > 0);
 
     // Add new items to the configuration state.
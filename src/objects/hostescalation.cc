@@ -196,7 +196,7 @@ hostescalation* add_host_escalation(
 
   try {
     // Duplicate vars.
-    obj->host_name = string::dup(host_name);
+    obj->host_name = string::intern(host_name);
     if (escalation_period)
       obj->escalation_period = string::dup(escalation_period);
     obj->escalate_on_down = (escalate_on_down > 0);
@@ -97,7 +97,7 @@ hostsmember* add_child_link_to_host(host* parent, host* child) {
   try {
     // Initialize values.
     obj->host_ptr = child;
-    obj->host_name = string::dup(child->name);
+    obj->host_name = string::intern(child->name);
 
     // Add the child entry to the host definition.
     obj->next = parent->child_hosts;
@@ -147,7 +147,7 @@ hostsmember* add_host_to_hostgroup(
 
   try {
     // Duplicate vars.
-    obj->host_name = string::dup(host_name);
+    obj->host_name = string::intern(host_name);
 
     // Add the new member to the member list, sorted by host name.
     hostsmember* last(grp->members);
@@ -219,7 +219,7 @@ hostsmember* add_parent_host_to_host(
 
   try {
     // Duplicate string vars.
-    obj->host_name = string::dup(host_name);
+    obj->host_name = string::intern(host_name);
 
     // Add the parent host entry to the host definition */
     obj->next = hst->parent_hosts;
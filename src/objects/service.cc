@@ -497,8 +497,8 @@ service* add_service(
 
   try {
     // Duplicate vars.
-    obj->host_name = string::dup(host_name);
-    obj->description = string::dup(description);
+    obj->host_name = string::intern(host_name);
+    obj->description = string::intern(description);
     obj->display_name = string::dup(display_name ? display_name : description);
     obj->service_check_command = string::dup(check_command);
     if (event_handler)
@@ -232,10 +232,10 @@ servicedependency* add_service_dependency(
 
   try {
     // Duplicate vars.
-    obj->dependent_host_name = string::dup(dependent_host_name);
-    obj->dependent_service_description = string::dup(dependent_service_description);
-    obj->host_name = string::dup(host_name);
-    obj->service_description = string::dup(service_description);
+    obj->dependent_host_name = string::intern(dependent_host_name);
+    obj->dependent_service_description = string::intern(dependent_service_description);
+    obj->host_name = string::intern(host_name);
+    obj->service_description = string::intern(service_description);
     if (dependency_period)
       obj->dependency_period = string::dup(dependency_period);
 
@@ -245,6 +245,16 @@ servicedependency* add_service_dependency(
     obj->fail_on_pending = (fail_on_pending == 1);
     obj->fail_on_unknown = (fail_on_unknown == 1);
     obj->fail_on_warning = (fail_on_warning == 1);
+    if (obj->fail_on_ok)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(STATE_OK);
+    if (obj->fail_on_warning)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(STATE_WARNING);
+    if (obj->fail_on_unknown)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(STATE_UNKNOWN);
+    if (obj->fail_on_critical)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_STATE(STATE_CRITICAL);
+    if (obj->fail_on_pending)
+      obj->fail_states |= DEPENDENCY_FAIL_ON_PENDING;
     obj->inherits_parent = (inherits_parent > 0);
 
     // Add new items to the configuration state.
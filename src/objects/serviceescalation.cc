@@ -212,8 +212,8 @@ serviceescalation* add_service_escalation(
 
   try {
     // Duplicate vars.
-    obj->host_name = string::dup(host_name);
-    obj->description = string::dup(description);
+    obj->host_name = string::intern(host_name);
+    obj->description = string::intern(description);
     if (escalation_period)
       obj->escalation_period = string::dup(escalation_period);
 
@@ -157,8 +157,8 @@ servicesmember* add_service_to_servicegroup(
 
   try {
     // Duplicate vars.
-    obj->host_name = string::dup(host_name);
-    obj->service_description = string::dup(svc_description);
+    obj->host_name = string::intern(host_name);
+    obj->service_description = string::intern(svc_description);
 
     // Add new member to member list.
     obj->next = grp->members;
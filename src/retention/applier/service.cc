@@ -157,6 +157,10 @@ void applier::service::_update(
         *state.state_history(),
         obj.state_history);
       obj.state_history_index = 0;
+      rebuild_state_history_changes(
+        obj.state_history,
+        obj.state_history_index,
+        &obj.state_changes);
     }
   }
 
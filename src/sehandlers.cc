@@ -24,6 +24,7 @@
 #include "com/centreon/engine/logging.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/summary.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
@@ -1077,6 +1078,9 @@ int handle_host_state(host* hst) {
       delete_host_acknowledgement_comments(hst);
     }
 
+    /* update totals of summary macros before notifications are sent */
+    com::centreon::engine::macros::summary::instance().update(hst);
+
     /* reset the next and last notification times */
     hst->last_host_notification = (time_t)0;
     hst->next_host_notification = (time_t)0;
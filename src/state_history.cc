@@ -0,0 +1,149 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/state_history.hh"
+
+// Weights of the oldest and of the newest state changes.
+static double const low_curve_value(0.75);
+static double const high_curve_value(1.25);
+
+// Distance to a threshold below which the fast computation of the
+// percent state change could lead to another decision than the
+// historical summation.
+static double const threshold_margin(1e-9);
+
+/**
+ *  Compute the percent state change like the historical algorithm,
+ *  by summing the weights of the changes from the oldest to the
+ *  newest.
+ *
+ *  @param[in] changes  State changes.
+ *
+ *  @return Percent state change.
+ */
+static double sum_percent_change(state_history_changes const* changes) {
+  double curved_changes(0.0);
+  for (unsigned int x(1); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    if (changes->mask & (1u << (x - 1)))
+      curved_changes
+        += (((double)(x - 1) * (high_curve_value - low_curve_value))
+            / ((double)(MAX_STATE_HISTORY_ENTRIES - 2))) + low_curve_value;
+  return ((curved_changes * 100.0)
+          / (double)(MAX_STATE_HISTORY_ENTRIES - 1));
+}
+
+/**
+ *  Get the percent state change of a state history. Change weights
+ *  grow linearly from the oldest to the newest change, so their sum
+ *  only depends on the number of changes and on the sum of their
+ *  positions. Close to a threshold, the historical summation is used
+ *  instead, to keep flapping decisions exactly the same.
+ *
+ *  @param[in] changes         State changes.
+ *  @param[in] low_threshold   Low flapping threshold.
+ *  @param[in] high_threshold  High flapping threshold.
+ *
+ *  @return Percent state change.
+ */
+double get_state_history_percent_change(
+         state_history_changes const* changes,
+         double low_threshold,
+         double high_threshold) {
+  double curved_changes(
+           ((double)(changes->positions - changes->count)
+            * (high_curve_value - low_curve_value))
+           / (double)(MAX_STATE_HISTORY_ENTRIES - 2)
+           + changes->count * low_curve_value);
+  double percent_change(
+           (curved_changes * 100.0)
+           / (double)(MAX_STATE_HISTORY_ENTRIES - 1));
+  double low_distance(percent_change - low_threshold);
+  double high_distance(percent_change - high_threshold);
+  if (((low_distance < threshold_margin)
+       && (low_distance > -threshold_margin))
+      || ((high_distance < threshold_margin)
+          && (high_distance > -threshold_margin)))
+    percent_change = sum_percent_change(changes);
+  return (percent_change);
+}
+
+/**
+ *  Record a state in a state history.
+ *
+ *  @param[in,out] history  State history of MAX_STATE_HISTORY_ENTRIES
+ *                          entries.
+ *  @param[in,out] index    Index of the oldest entry, that will be
+ *                          replaced.
+ *  @param[in,out] changes  State changes of the history.
+ *  @param[in]     state    New state.
+ */
+void push_state_history(
+       int history[],
+       unsigned int* index,
+       state_history_changes* changes,
+       int state) {
+  // The oldest change leaves the history, others get one position
+  // older.
+  if (changes->mask & 1) {
+    --changes->count;
+    --changes->positions;
+  }
+  changes->positions -= changes->count;
+  changes->mask >>= 1;
+
+  // Is the new state a change ?
+  unsigned int newest((*index + MAX_STATE_HISTORY_ENTRIES - 1)
+                      % MAX_STATE_HISTORY_ENTRIES);
+  if (history[newest] != state) {
+    ++changes->count;
+    changes->positions += MAX_STATE_HISTORY_ENTRIES - 1;
+    changes->mask |= 1u << (MAX_STATE_HISTORY_ENTRIES - 2);
+  }
+
+  history[*index] = state;
+  if (++*index >= MAX_STATE_HISTORY_ENTRIES)
+    *index = 0;
+  return ;
+}
+
+/**
+ *  Compute the state changes of a state history that was not filled
+ *  with push_state_history().
+ *
+ *  @param[in]  history  State history of MAX_STATE_HISTORY_ENTRIES
+ *                       entries.
+ *  @param[in]  index    Index of the oldest entry.
+ *  @param[out] changes  State changes of the history.
+ */
+void rebuild_state_history_changes(
+       int const history[],
+       unsigned int index,
+       state_history_changes* changes) {
+  changes->count = 0;
+  changes->mask = 0;
+  changes->positions = 0;
+  for (unsigned int x(1); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    if (history[(index + x - 1) % MAX_STATE_HISTORY_ENTRIES]
+        != history[(index + x) % MAX_STATE_HISTORY_ENTRIES]) {
+      ++changes->count;
+      changes->mask |= 1u << (x - 1);
+      changes->positions += x;
+    }
+  return ;
+}
@@ -19,11 +19,22 @@
 
 #include "com/centreon/engine/error.hh"
 #include "com/centreon/engine/string.hh"
+#include "com/centreon/unordered_hash.hh"
 
 using namespace com::centreon::engine;
 
 static char const* whitespaces(" \t\r\n");
 
+/**
+ *  Get the table of interned strings, with their reference counts.
+ *
+ *  @return Table of interned strings.
+ */
+static umap<std::string, unsigned int>& interned_strings() {
+  static umap<std::string, unsigned int> table;
+  return (table);
+}
+
 /**
  *  Get the next valid line.
  *
@@ -49,6 +60,28 @@ bool string::get_next_line(
   return (false);
 }
 
+/**
+ *  Get the shared copy of a string. Objects names are repeated in
+ *  many objects (services of a host, group members, dependencies,
+ *  escalations), they are stored once. The returned buffer must not
+ *  be modified and must be released with unintern(), not deleted.
+ *
+ *  This is not thread-safe, objects are created and deleted by the
+ *  configuration applier only.
+ *
+ *  @param[in] value  String to intern, can be NULL.
+ *
+ *  @return Shared copy of value, NULL if value is NULL.
+ */
+char* string::intern(char const* value) {
+  if (!value)
+    return (NULL);
+  umap<std::string, unsigned int>::iterator
+    it(interned_strings().insert(std::make_pair(value, 0u)).first);
+  ++it->second;
+  return (const_cast<char*>(it->first.c_str()));
+}
+
 /**
  *  Get key and value from line.
  *
@@ -268,3 +301,22 @@ std::string& string::trim_right(std::string& str) throw () {
     str.erase(pos + 1);
   return (str);
 }
+
+/**
+ *  Release a string returned by intern(). The shared copy is deleted
+ *  with its last reference.
+ *
+ *  @param[in] value  Interned string, can be NULL.
+ */
+void string::unintern(char const* value) throw () {
+  if (!value)
+    return ;
+  try {
+    umap<std::string, unsigned int>::iterator
+      it(interned_strings().find(value));
+    if (it != interned_strings().end() && !--it->second)
+      interned_strings().erase(it);
+  }
+  catch (...) {}
+  return ;
+}
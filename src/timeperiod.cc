@@ -19,14 +19,22 @@
 ** <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <ctime>
+#include <utility>
+#include <vector>
+#include "com/centreon/concurrency/locker.hh"
+#include "com/centreon/concurrency/mutex.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/objects/daterange.hh"
 #include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/timerange.hh"
 #include "com/centreon/engine/timeperiod.hh"
+#include "com/centreon/engine/timezone_manager.hh"
+#include "com/centreon/unordered_hash.hh"
 
+using namespace com::centreon;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::logging;
 
@@ -36,6 +44,54 @@ static void _get_next_valid_time_per_timeperiod(
               time_t* valid_time,
               timeperiod* tperiod);
 
+// Number of days covered by a compiled calendar.
+static int const calendar_days(14);
+
+/**
+ *  Valid time intervals of a timeperiod, compiled in some timezone
+ *  from midnight of the current day and for calendar_days days.
+ *  Intervals are sorted and disjoint.
+ */
+struct timeperiod_calendar {
+  time_t           end;
+  std::vector<std::pair<time_t, time_t> >
+                   intervals;
+  time_t           last_from;
+  int              last_result;
+  time_t           last_until;
+  time_t           renew;
+  time_t           start;
+  timezone_info const*
+                   zone;
+};
+
+// Compiled calendars, indexed by timeperiod.
+static umap<timeperiod*, std::vector<timeperiod_calendar> >
+                           _calendars;
+static concurrency::mutex  _calendars_lock;
+
+/**
+ *  Break a time down in the current timezone.
+ *
+ *  @param[in]  t       Time.
+ *  @param[out] result  Broken-down time.
+ */
+static void _localtime(time_t t, struct tm* result) {
+  timezone_manager::instance().get_current().localtime(t, result);
+  return ;
+}
+
+/**
+ *  Convert a broken-down time of the current timezone.
+ *
+ *  @param[in,out] t  Broken-down time.
+ *
+ *  @return Time.
+ */
+static time_t _mktime(struct tm* t) {
+  return (timezone_manager::instance().get_current().mktime(t));
+}
+
 /**
  *  Add a round number of days (expressed in seconds) to a date.
  *
@@ -48,7 +104,7 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
   // Compute expected time with no DST.
   time_t next_day_time(midnight + skip);
   struct tm next_day;
-  localtime_r(&next_day_time, &next_day);
+  _localtime(next_day_time, &next_day);
 
   // There was a DST shift in between.
   if (next_day.tm_hour || next_day.tm_min || next_day.tm_sec) {
@@ -59,12 +115,12 @@ static time_t _add_round_days_to_midnight(time_t midnight, time_t skip) {
     ** time to midnight, convert back and we're done.
     */
     next_day_time += 12 * 60 * 60;
-    localtime_r(&next_day_time, &next_day);
+    _localtime(next_day_time, &next_day);
     next_day.tm_hour = 0;
     next_day.tm_min = 0;
     next_day.tm_sec = 0;
     next_day.tm_isdst = -1;
-    next_day_time = mktime(&next_day);
+    next_day_time = _mktime(&next_day);
   }
 
   return (next_day_time);
@@ -96,7 +152,7 @@ static time_t calculate_time_from_day_of_month(
     t.tm_mon = month;
     t.tm_mday = monthday;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = _mktime(&t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -116,7 +172,7 @@ static time_t calculate_time_from_day_of_month(
       t.tm_year = year;
       t.tm_mday = day;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = _mktime(&t);
     } while ((midnight == (time_t)-1)
              || (t.tm_mon != month));
 
@@ -130,7 +186,7 @@ static time_t calculate_time_from_day_of_month(
     else
       t.tm_mday += monthday + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = _mktime(&t);
   }
 
   return (midnight);
@@ -162,7 +218,7 @@ static time_t calculate_time_from_weekday_of_month(
   t.tm_mon = month;
   t.tm_mday = 1;
   t.tm_isdst = -1;
-  time_t midnight(mktime(&t));
+  time_t midnight(_mktime(&t));
 
   // How many days must we advance to reach the first instance of the
   // weekday this month ?
@@ -181,7 +237,7 @@ static time_t calculate_time_from_weekday_of_month(
     t.tm_year = year;
     t.tm_mday = days + 1;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = _mktime(&t);
 
     // If we rolled over to the next month, time is invalid, assume the
     // user's intention is to keep it in the current month.
@@ -201,7 +257,7 @@ static time_t calculate_time_from_weekday_of_month(
       t.tm_year = year;
       t.tm_mday = days + 1;
       t.tm_isdst = -1;
-      midnight = mktime(&t);
+      midnight = _mktime(&t);
     } while ((midnight == (time_t)-1)
              || (t.tm_mon != month));
 
@@ -215,7 +271,7 @@ static time_t calculate_time_from_weekday_of_month(
     else
       t.tm_mday += days;
     t.tm_isdst = -1;
-    midnight = mktime(&t);
+    midnight = _mktime(&t);
   }
 
   return (midnight);
@@ -255,7 +311,7 @@ static bool _daterange_calendar_date_to_time_t(
   t.tm_mday = r.smday;
   t.tm_mon = r.smon;
   t.tm_year = r.syear - 1900;
-  if ((start = mktime(&t)) == (time_t)-1)
+  if ((start = _mktime(&t)) == (time_t)-1)
     return (false);
 
   if (r.eyear) {
@@ -266,7 +322,7 @@ static bool _daterange_calendar_date_to_time_t(
     t.tm_mday = r.emday;
     t.tm_mon = r.emon;
     t.tm_year = r.eyear - 1900;
-    if ((end = mktime(&t)) == (time_t)-1)
+    if ((end = _mktime(&t)) == (time_t)-1)
       return (false);
     end = _add_round_days_to_midnight(end, 24 * 60 * 60);
   }
@@ -694,14 +750,195 @@ static bool _timerange_to_time_t(
   my_tm.tm_hour = trange->range_start / 60 / 60;
   my_tm.tm_min = (trange->range_start / 60) % 60;
   my_tm.tm_isdst = -1;
-  range_start = mktime(&my_tm);
+  range_start = _mktime(&my_tm);
   my_tm.tm_hour = trange->range_end / 60 / 60;
   my_tm.tm_min = (trange->range_end / 60) % 60;
   my_tm.tm_isdst = -1;
-  range_end = mktime(&my_tm);
+  range_end = _mktime(&my_tm);
   return (range_start <= range_end);
 }
 
+/**
+ *  Get a timeperiod and all the timeperiods it (recursively) excludes.
+ *
+ *  @param[in]  tperiod  Time period.
+ *  @param[out] tperiods Time periods.
+ */
+static void _get_calendar_timeperiods(
+              timeperiod* tperiod,
+              std::vector<timeperiod*>& tperiods) {
+  if (!tperiod
+      || (std::find(tperiods.begin(), tperiods.end(), tperiod)
+          != tperiods.end()))
+    return ;
+  tperiods.push_back(tperiod);
+  for (timeperiodexclusion* exclusion(tperiod->exclusions);
+       exclusion;
+       exclusion = exclusion->next)
+    _get_calendar_timeperiods(exclusion->timeperiod_ptr, tperiods);
+  return ;
+}
+
+/**
+ *  Add time range limits of a day to calendar boundaries.
+ *
+ *  @param[in]  trange      Time ranges.
+ *  @param[in]  midnight    Midnight of day.
+ *  @param[out] boundaries  Boundaries.
+ */
+static void _add_calendar_boundaries(
+              timerange* trange,
+              struct tm const* midnight,
+              std::vector<time_t>& boundaries) {
+  for (; trange; trange = trange->next) {
+    time_t range_start((time_t)-1);
+    time_t range_end((time_t)-1);
+    if (_timerange_to_time_t(trange, midnight, range_start, range_end)) {
+      boundaries.push_back(range_start);
+      boundaries.push_back(range_end);
+    }
+  }
+  return ;
+}
+
+/**
+ *  Compile the calendar of a timeperiod.
+ *
+ *  Validity of a timeperiod can only change at midnight or at a time
+ *  range limit of the timeperiod or of one of its exclusions. The
+ *  original algorithm is evaluated at each of these boundaries and the
+ *  result is stored as a list of valid intervals, exclusions being
+ *  already subtracted.
+ *
+ *  @param[in]  tperiod  Time period.
+ *  @param[in]  now      Current time.
+ *  @param[out] cal      Calendar.
+ */
+static void _compile_calendar(
+              timeperiod* tperiod,
+              time_t now,
+              timeperiod_calendar& cal) {
+  struct tm midnight;
+  _localtime(now, &midnight);
+  midnight.tm_sec = 0;
+  midnight.tm_min = 0;
+  midnight.tm_hour = 0;
+  midnight.tm_isdst = -1;
+  cal.start = _mktime(&midnight);
+  cal.renew = _add_round_days_to_midnight(cal.start, 24 * 60 * 60);
+  cal.end = _add_round_days_to_midnight(
+              cal.start,
+              calendar_days * 24 * 60 * 60);
+  cal.intervals.clear();
+  cal.last_from = 0;
+  cal.last_until = 0;
+
+  // Get all boundaries of the calendar.
+  std::vector<timeperiod*> tperiods;
+  _get_calendar_timeperiods(tperiod, tperiods);
+  std::vector<time_t> boundaries;
+  for (time_t day(cal.start);
+       day < cal.end;
+       day = _add_round_days_to_midnight(day, 24 * 60 * 60)) {
+    boundaries.push_back(day);
+    _localtime(day, &midnight);
+    for (std::vector<timeperiod*>::const_iterator
+           it(tperiods.begin()), end(tperiods.end());
+         it != end;
+         ++it) {
+      for (unsigned int i(0); i < 7; ++i)
+        _add_calendar_boundaries((*it)->days[i], &midnight, boundaries);
+      for (unsigned int i(0); i < DATERANGE_TYPES; ++i)
+        for (daterange* drange((*it)->exceptions[i]);
+             drange;
+             drange = drange->next)
+          _add_calendar_boundaries(drange->times, &midnight, boundaries);
+    }
+  }
+  boundaries.push_back(cal.end);
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(
+    std::unique(boundaries.begin(), boundaries.end()),
+    boundaries.end());
+
+  // Evaluate validity between boundaries.
+  std::vector<time_t>::const_iterator next(boundaries.begin());
+  time_t current(cal.start);
+  while (current < cal.end) {
+    time_t valid((time_t)-1);
+    _get_next_valid_time_per_timeperiod(current, &valid, tperiod);
+    while ((next != boundaries.end()) && (*next <= current))
+      ++next;
+    if (valid == current) {
+      time_t interval_end((next != boundaries.end()) ? *next : cal.end);
+      if (!cal.intervals.empty()
+          && (cal.intervals.back().second == current))
+        cal.intervals.back().second = interval_end;
+      else
+        cal.intervals.push_back(std::make_pair(current, interval_end));
+      current = interval_end;
+    }
+    else if (valid > current)
+      current = valid;
+    else
+      current = ((next != boundaries.end()) ? *next : cal.end);
+  }
+  return ;
+}
+
+/**
+ *  Get the calendar of a timeperiod in the current timezone. The
+ *  calendar is compiled if it does not exist yet or if it starts
+ *  another day. _calendars_lock must be held.
+ *
+ *  @param[in] tperiod  Time period.
+ *
+ *  @return Calendar.
+ */
+static timeperiod_calendar& _find_calendar(timeperiod* tperiod) {
+  time_t now(time(NULL));
+  timezone_info const* zone(
+    &timezone_manager::instance().get_current());
+  std::vector<timeperiod_calendar>& calendars(_calendars[tperiod]);
+  for (std::vector<timeperiod_calendar>::iterator
+         it(calendars.begin()), end(calendars.end());
+       it != end;
+       ++it)
+    if (it->zone == zone) {
+      if ((now < it->start) || (now >= it->renew))
+        _compile_calendar(tperiod, now, *it);
+      return (*it);
+    }
+  calendars.push_back(timeperiod_calendar());
+  calendars.back().zone = zone;
+  _compile_calendar(tperiod, now, calendars.back());
+  return (calendars.back());
+}
+
+/**
+ *  Compare the end of an interval with a time.
+ *
+ *  @param[in] t         Time.
+ *  @param[in] interval  Interval.
+ *
+ *  @return true if t is strictly before the end of interval.
+ */
+static bool _is_before_interval_end(
+              time_t t,
+              std::pair<time_t, time_t> const& interval) {
+  return (t < interval.second);
+}
+
+/**
+ *  Drop all compiled timeperiod calendars. Must be called when
+ *  timeperiods are modified or deleted.
+ */
+void clear_timeperiod_calendars() {
+  concurrency::locker lock(&_calendars_lock);
+  _calendars.clear();
+  return ;
+}
+
 /**
  *  See if the specified time falls into a valid time range in the given
  *  time period.
@@ -721,6 +958,40 @@ int check_time_against_period(
   if (!tperiod)
     return (OK);
 
+  // Look up the compiled calendar.
+  {
+    concurrency::locker lock(&_calendars_lock);
+    timeperiod_calendar& cal(_find_calendar(tperiod));
+    if ((test_time >= cal.last_from) && (test_time < cal.last_until))
+      return (cal.last_result);
+    if ((test_time >= cal.start) && (test_time < cal.end)) {
+      // Remember the interval or the gap between intervals that
+      // contains the tested time, as callers usually test the same
+      // period again and again with the current time.
+      std::vector<std::pair<time_t, time_t> >::const_iterator
+        it(std::upper_bound(
+                 cal.intervals.begin(),
+                 cal.intervals.end(),
+                 test_time,
+                 &_is_before_interval_end));
+      if ((it != cal.intervals.end()) && (it->first <= test_time)) {
+        cal.last_from = it->first;
+        cal.last_until = it->second;
+        cal.last_result = OK;
+      }
+      else {
+        cal.last_from = ((it == cal.intervals.begin())
+                         ? cal.start
+                         : (it - 1)->second);
+        cal.last_until = ((it == cal.intervals.end())
+                          ? cal.end
+                          : it->first);
+        cal.last_result = ERROR;
+      }
+      return (cal.last_result);
+    }
+  }
+
   // Faked next valid time must be tested time.
   time_t next_valid_time((time_t)-1);
   _get_next_valid_time_per_timeperiod(
@@ -766,12 +1037,12 @@ static void _get_next_invalid_time_per_timeperiod(
     // Compute time information.
     time_info ti;
     ti.preferred_time = preferred_time;
-    localtime_r(&preferred_time, &ti.preftime);
+    _localtime(preferred_time, &ti.preftime);
     ti.preftime.tm_sec = 0;
     ti.preftime.tm_min = 0;
     ti.preftime.tm_hour = 0;
     ti.preftime.tm_isdst = -1;
-    ti.midnight = mktime(&ti.preftime);
+    ti.midnight = _mktime(&ti.preftime);
 
     // XXX: handle range end reached.
     // Browse all date range.
@@ -801,7 +1072,7 @@ static void _get_next_invalid_time_per_timeperiod(
           if (earliest_midnight != (time_t)-1) {
             // Midnight.
             struct tm midnight;
-            localtime_r(&earliest_midnight, &midnight);
+            _localtime(earliest_midnight, &midnight);
 
             // Browse all time range of date range.
             for (timerange* trange(drange->times);
@@ -840,7 +1111,7 @@ static void _get_next_invalid_time_per_timeperiod(
                          ti.midnight,
                          days_into_the_future * 24 * 60 * 60));
       struct tm day_midnight;
-      localtime_r(&day_start, &day_midnight);
+      _localtime(day_start, &day_midnight);
 
       // Check all time ranges for this day of the week.
       for (timerange* trange(tperiod->days[weekday]);
@@ -926,7 +1197,7 @@ static time_t _get_next_valid_time_in_timeranges(
                 timerange* timeranges) {
   time_t earliest_time((time_t)-1);
   struct tm midnight;
-  localtime_r(&preferred_time, &midnight);
+  _localtime(preferred_time, &midnight);
   midnight.tm_hour = 0;
   midnight.tm_min = 0;
   midnight.tm_sec = 0;
@@ -986,12 +1257,12 @@ static void _get_next_valid_time_per_timeperiod(
        (earliest_time == (time_t)-1)
        && (ti.preferred_time < in_one_year);) {
     // Compute time information.
-    localtime_r(&ti.preferred_time, &ti.preftime);
+    _localtime(ti.preferred_time, &ti.preftime);
     ti.preftime.tm_sec = 0;
     ti.preftime.tm_min = 0;
     ti.preftime.tm_hour = 0;
     ti.preftime.tm_isdst = -1;
-    ti.midnight = mktime(&ti.preftime);
+    ti.midnight = _mktime(&ti.preftime);
 
     // Browse all date range types in precedence order.
     bool skip_this_day(false);
@@ -1127,6 +1398,25 @@ void get_next_valid_time(
   // First check for possible timeperiod exclusions
   // before getting a valid_time.
   else {
+    // Look up the compiled calendar.
+    {
+      concurrency::locker lock(&_calendars_lock);
+      timeperiod_calendar const& cal(_find_calendar(tperiod));
+      if ((preferred_time >= cal.start) && (preferred_time < cal.end)) {
+        std::vector<std::pair<time_t, time_t> >::const_iterator
+          it(std::upper_bound(
+                   cal.intervals.begin(),
+                   cal.intervals.end(),
+                   preferred_time,
+                   &_is_before_interval_end));
+        if (it != cal.intervals.end()) {
+          *valid_time = std::max(it->first, preferred_time);
+          return ;
+        }
+      }
+    }
+
+    // Out of the calendar, compute it.
     *valid_time = 0;
     _get_next_valid_time_per_timeperiod(
       preferred_time,
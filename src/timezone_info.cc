@@ -0,0 +1,688 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "com/centreon/engine/timezone_info.hh"
+
+using namespace com::centreon::engine;
+
+// Default zoneinfo directory and local timezone file.
+static char const* const default_tzdir("/usr/share/zoneinfo");
+static char const* const default_tzfile("/etc/localtime");
+
+// Maximum number of transitions browsed to honor a DST flag.
+static unsigned int const max_dst_lookup(8);
+
+/**
+ *  Integer division rounded towards negative infinity.
+ *
+ *  @param[in] a  Dividend.
+ *  @param[in] b  Divisor (positive).
+ *
+ *  @return a / b rounded down.
+ */
+static long floor_div(time_t a, long b) {
+  return (static_cast<long>((a >= 0) ? (a / b) : -((-a + b - 1) / b)));
+}
+
+/**
+ *  Get the number of days from 1970-01-01 to a civil date.
+ *
+ *  @param[in] year   Year.
+ *  @param[in] month  Month (1-12).
+ *  @param[in] day    Day of month (1-31).
+ *
+ *  @return Number of days, negative before epoch.
+ */
+static long days_from_civil(long year, int month, int day) {
+  year -= (month <= 2);
+  long era(floor_div(year, 400));
+  long yoe(year - era * 400);
+  long doy((153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1);
+  long doe(yoe * 365 + yoe / 4 - yoe / 100 + doy);
+  return (era * 146097 + doe - 719468);
+}
+
+/**
+ *  Get the civil date of a number of days from 1970-01-01.
+ *
+ *  @param[in]  days   Number of days.
+ *  @param[out] year   Year.
+ *  @param[out] month  Month (1-12).
+ *  @param[out] day    Day of month (1-31).
+ */
+static void civil_from_days(long days, long& year, int& month, int& day) {
+  days += 719468;
+  long era(floor_div(days, 146097));
+  long doe(days - era * 146097);
+  long yoe((doe - doe / 1460 + doe / 36524 - doe / 146096) / 365);
+  long doy(doe - (365 * yoe + yoe / 4 - yoe / 100));
+  long mp((5 * doy + 2) / 153);
+  day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  year = yoe + era * 400 + (month <= 2);
+  return ;
+}
+
+/**
+ *  Check if a year is a leap year.
+ *
+ *  @param[in] year  Year.
+ *
+ *  @return true if year is a leap year.
+ */
+static bool is_leap_year(long year) {
+  return (!(year % 4) && ((year % 100) || !(year % 400)));
+}
+
+/**
+ *  Read a big endian signed integer.
+ *
+ *  @param[in] data  Data.
+ *  @param[in] size  Integer size (4 or 8).
+ *
+ *  @return Integer value.
+ */
+static time_t read_be(unsigned char const* data, unsigned int size) {
+  unsigned long long value(0);
+  for (unsigned int i(0); i < size; ++i)
+    value = (value << 8) | data[i];
+  if (size == 4)
+    return (static_cast<time_t>(static_cast<int>(
+                                  static_cast<unsigned int>(value))));
+  return (static_cast<time_t>(static_cast<long long>(value)));
+}
+
+/**
+ *  Parse a number of a POSIX TZ string.
+ *
+ *  @param[in,out] p      Current position.
+ *  @param[out]    value  Parsed number.
+ *
+ *  @return true if a number was parsed.
+ */
+static bool parse_number(char const*& p, long& value) {
+  if ((*p < '0') || (*p > '9'))
+    return (false);
+  value = 0;
+  while ((*p >= '0') && (*p <= '9'))
+    value = value * 10 + (*p++ - '0');
+  return (true);
+}
+
+/**
+ *  Parse an [+-]hh[:mm[:ss]] time of a POSIX TZ string.
+ *
+ *  @param[in,out] p      Current position.
+ *  @param[out]    value  Parsed time in seconds.
+ *
+ *  @return true if a time was parsed.
+ */
+static bool parse_time(char const*& p, long& value) {
+  long sign(1);
+  if ((*p == '+') || (*p == '-'))
+    sign = ((*p++ == '-') ? -1 : 1);
+  long hours(0);
+  if (!parse_number(p, hours))
+    return (false);
+  long minutes(0);
+  long seconds(0);
+  if ((*p == ':') && (++p, !parse_number(p, minutes)))
+    return (false);
+  if ((*p == ':') && (++p, !parse_number(p, seconds)))
+    return (false);
+  value = sign * (hours * 3600 + minutes * 60 + seconds);
+  return (true);
+}
+
+/**
+ *  Parse a timezone abbreviation of a POSIX TZ string.
+ *
+ *  @param[in,out] p     Current position.
+ *  @param[out]    name  Parsed abbreviation.
+ *
+ *  @return true if an abbreviation was parsed.
+ */
+static bool parse_abbreviation(char const*& p, std::string& name) {
+  name.clear();
+  if (*p == '<') {
+    for (++p; *p && (*p != '>'); ++p)
+      name.push_back(*p);
+    if (*p != '>')
+      return (false);
+    ++p;
+  }
+  else
+    while (((*p >= 'a') && (*p <= 'z')) || ((*p >= 'A') && (*p <= 'Z')))
+      name.push_back(*p++);
+  return (name.size() >= 3);
+}
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] tz  Timezone, in the format of the TZ environment
+ *                 variable. NULL means the local timezone of the
+ *                 system.
+ */
+timezone_info::timezone_info(char const* tz)
+  : _has_rule(false) {
+  bool loaded(false);
+  if (!tz)
+    loaded = _load_file(default_tzfile);
+  else {
+    _name = tz;
+    char const* name(tz);
+    if (*name == ':')
+      ++name;
+    if (*name) {
+      std::string path;
+      if (*name == '/')
+        path = name;
+      else {
+        char const* tzdir(getenv("TZDIR"));
+        path = ((tzdir && *tzdir) ? tzdir : default_tzdir);
+        path.append("/");
+        path.append(name);
+      }
+      loaded = _load_file(path);
+      if (!loaded && (*tz != ':'))
+        loaded = _parse_posix(name);
+    }
+  }
+
+  // Unknown timezones are UTC.
+  if (!loaded) {
+    _has_rule = false;
+    _transitions.clear();
+    _types.clear();
+    ttinfo utc;
+    utc.abbreviation = "UTC";
+    utc.gmtoff = 0;
+    utc.isdst = false;
+    _ttinfos.assign(1, utc);
+  }
+}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] other  Object to copy.
+ */
+timezone_info::timezone_info(timezone_info const& other) {
+  _copy(other);
+}
+
+/**
+ *  Destructor.
+ */
+timezone_info::~timezone_info() throw () {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] other  Object to copy.
+ *
+ *  @return This object.
+ */
+timezone_info& timezone_info::operator=(timezone_info const& other) {
+  if (this != &other)
+    _copy(other);
+  return (*this);
+}
+
+/**
+ *  Get timezone name.
+ *
+ *  @return Timezone name, as it was given at construction. Empty for
+ *          the local timezone of the system.
+ */
+std::string const& timezone_info::get_name() const throw () {
+  return (_name);
+}
+
+/**
+ *  Break a time down in this timezone, like localtime_r().
+ *
+ *  @param[in]  t       Time.
+ *  @param[out] result  Broken-down time.
+ */
+void timezone_info::localtime(time_t t, struct tm* result) const {
+  ttinfo const& info(_find_ttinfo(t));
+  time_t local(t + info.gmtoff);
+  long days(floor_div(local, 24 * 60 * 60));
+  long seconds(static_cast<long>(local - days * 24 * 60 * 60));
+  long year;
+  int month;
+  int day;
+  civil_from_days(days, year, month, day);
+  result->tm_sec = static_cast<int>(seconds % 60);
+  result->tm_min = static_cast<int>((seconds / 60) % 60);
+  result->tm_hour = static_cast<int>(seconds / 3600);
+  result->tm_mday = day;
+  result->tm_mon = month - 1;
+  result->tm_year = static_cast<int>(year - 1900);
+  result->tm_wday = static_cast<int>(((days % 7) + 11) % 7);
+  result->tm_yday = static_cast<int>(
+                      days - days_from_civil(year, 1, 1));
+  result->tm_isdst = info.isdst;
+#ifdef HAVE_TM_ZONE
+  result->tm_gmtoff = info.gmtoff;
+  result->tm_zone = info.abbreviation.c_str();
+#endif // HAVE_TM_ZONE
+  return ;
+}
+
+/**
+ *  Convert a broken-down time of this timezone, like mktime().
+ *
+ *  Out of range fields are normalized. When tm_isdst is negative,
+ *  times that occur twice (backward DST shift) are resolved to their
+ *  first occurrence and times that do not exist (forward DST shift)
+ *  are shifted by the DST offset.
+ *
+ *  @param[in,out] t  Broken-down time, normalized on return.
+ *
+ *  @return Time.
+ */
+time_t timezone_info::mktime(struct tm* t) const {
+  long year(t->tm_year + 1900L + floor_div(t->tm_mon, 12));
+  int month(static_cast<int>(t->tm_mon - floor_div(t->tm_mon, 12) * 12));
+  time_t local(
+           static_cast<time_t>(days_from_civil(year, month + 1, 1))
+           * 24 * 60 * 60
+           + (t->tm_mday - 1) * 24 * 60 * 60L
+           + t->tm_hour * 60 * 60L
+           + t->tm_min * 60L
+           + t->tm_sec);
+
+  time_t result;
+  long gmtoff(0);
+  if ((t->tm_isdst >= 0) && _find_offset(local, t->tm_isdst > 0, gmtoff))
+    result = local - gmtoff;
+  else {
+    long before(_find_ttinfo(local - 24 * 60 * 60).gmtoff);
+    long after(_find_ttinfo(local + 24 * 60 * 60).gmtoff);
+    bool before_valid(_find_ttinfo(local - before).gmtoff == before);
+    bool after_valid(_find_ttinfo(local - after).gmtoff == after);
+    if (before_valid && after_valid)
+      result = std::min(local - before, local - after);
+    else if (after_valid)
+      result = local - after;
+    else
+      result = local - before;
+  }
+  localtime(result, t);
+  return (result);
+}
+
+/**
+ *  Copy internal data members.
+ *
+ *  @param[in] other  Object to copy.
+ */
+void timezone_info::_copy(timezone_info const& other) {
+  _dst_end = other._dst_end;
+  _dst_start = other._dst_start;
+  _has_rule = other._has_rule;
+  _name = other._name;
+  _rule_dst = other._rule_dst;
+  _rule_std = other._rule_std;
+  _transitions = other._transitions;
+  _ttinfos = other._ttinfos;
+  _types = other._types;
+  return ;
+}
+
+/**
+ *  Find the UTC offset to use for a local time with a given DST flag.
+ *
+ *  @param[in]  local   Local time (seconds from epoch, local clock).
+ *  @param[in]  isdst   Expected DST flag.
+ *  @param[out] gmtoff  UTC offset.
+ *
+ *  @return true if an offset with this DST flag was found.
+ */
+bool timezone_info::_find_offset(
+                      time_t local,
+                      bool isdst,
+                      long& gmtoff) const {
+  // Around local time.
+  time_t around[] = {
+    local - 24 * 60 * 60,
+    local + 24 * 60 * 60
+  };
+  for (unsigned int i(0); i < sizeof(around) / sizeof(*around); ++i) {
+    ttinfo const& info(_find_ttinfo(around[i]));
+    if (info.isdst == isdst) {
+      gmtoff = info.gmtoff;
+      return (true);
+    }
+  }
+
+  // Rule offsets.
+  if (_has_rule
+      && (_transitions.empty() || (local >= _transitions.back()))
+      && !_rule_dst.abbreviation.empty()) {
+    gmtoff = (isdst ? _rule_dst.gmtoff : _rule_std.gmtoff);
+    return (true);
+  }
+
+  // Nearest transitions.
+  size_t pos(std::upper_bound(
+                    _transitions.begin(),
+                    _transitions.end(),
+                    local) - _transitions.begin());
+  for (size_t i(1); i <= max_dst_lookup; ++i) {
+    if ((pos >= i) && (_ttinfos[_types[pos - i]].isdst == isdst)) {
+      gmtoff = _ttinfos[_types[pos - i]].gmtoff;
+      return (true);
+    }
+    if ((pos + i - 1 < _types.size())
+        && (_ttinfos[_types[pos + i - 1]].isdst == isdst)) {
+      gmtoff = _ttinfos[_types[pos + i - 1]].gmtoff;
+      return (true);
+    }
+  }
+  return (false);
+}
+
+/**
+ *  Find the local time type in use at some time.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Local time type.
+ */
+timezone_info::ttinfo const& timezone_info::_find_ttinfo(
+                                              time_t t) const {
+  if (_transitions.empty() || (t >= _transitions.back())) {
+    if (_has_rule)
+      return (_rule_ttinfo(t));
+    if (_transitions.empty())
+      return (_ttinfos.front());
+  }
+  if (t < _transitions.front())
+    return (_ttinfos.front());
+  size_t pos(std::upper_bound(
+                    _transitions.begin(),
+                    _transitions.end(),
+                    t) - _transitions.begin());
+  return (_ttinfos[_types[pos - 1]]);
+}
+
+/**
+ *  Load a TZif file of the zoneinfo database.
+ *
+ *  @param[in] path  File path.
+ *
+ *  @return true on success.
+ */
+bool timezone_info::_load_file(std::string const& path) {
+  std::ifstream stream(path.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    return (false);
+  std::string content(
+                (std::istreambuf_iterator<char>(stream)),
+                std::istreambuf_iterator<char>());
+  unsigned char const* data(
+    reinterpret_cast<unsigned char const*>(content.data()));
+  size_t size(content.size());
+
+  // Header: magic, version and counts.
+  size_t const header_size(44);
+  if ((size < header_size) || content.compare(0, 4, "TZif"))
+    return (false);
+  char version(content[4]);
+  unsigned int time_size(4);
+  size_t pos(0);
+  for (unsigned int pass(0); pass < 2; ++pass) {
+    if ((size < pos + header_size) || content.compare(pos, 4, "TZif"))
+      return (false);
+    size_t isutcnt(read_be(data + pos + 20, 4));
+    size_t isstdcnt(read_be(data + pos + 24, 4));
+    size_t leapcnt(read_be(data + pos + 28, 4));
+    size_t timecnt(read_be(data + pos + 32, 4));
+    size_t typecnt(read_be(data + pos + 36, 4));
+    size_t charcnt(read_be(data + pos + 40, 4));
+    pos += header_size;
+    size_t block_size(timecnt * time_size
+                      + timecnt
+                      + typecnt * 6
+                      + charcnt
+                      + leapcnt * (time_size + 4)
+                      + isstdcnt
+                      + isutcnt);
+    if (!typecnt || (size < pos + block_size))
+      return (false);
+
+    // Version 1 data are followed by the same data with 64 bits times.
+    if (!pass && (version >= '2')) {
+      pos += block_size;
+      time_size = 8;
+      continue ;
+    }
+
+    // Transitions.
+    std::vector<time_t> transitions(timecnt);
+    for (size_t i(0); i < timecnt; ++i, pos += time_size)
+      transitions[i] = read_be(data + pos, time_size);
+    std::vector<unsigned char> types(data + pos, data + pos + timecnt);
+    pos += timecnt;
+    for (size_t i(0); i < timecnt; ++i)
+      if (types[i] >= typecnt)
+        return (false);
+
+    // Local time types.
+    std::vector<ttinfo> ttinfos(typecnt);
+    char const* abbreviations(
+                  content.data() + pos + typecnt * 6);
+    for (size_t i(0); i < typecnt; ++i, pos += 6) {
+      ttinfos[i].gmtoff = static_cast<long>(read_be(data + pos, 4));
+      ttinfos[i].isdst = data[pos + 4];
+      size_t index(data[pos + 5]);
+      if (index < charcnt)
+        ttinfos[i].abbreviation.assign(
+          abbreviations + index,
+          strnlen(abbreviations + index, charcnt - index));
+    }
+    pos += block_size
+           - timecnt * time_size
+           - timecnt
+           - typecnt * 6;
+
+    _transitions.swap(transitions);
+    _types.swap(types);
+    _ttinfos.swap(ttinfos);
+    break ;
+  }
+
+  // Footer of version 2+ files: rule for times after the last
+  // transition.
+  _has_rule = false;
+  if ((version >= '2') && (pos < size) && (content[pos] == '\n')) {
+    size_t end(content.find('\n', pos + 1));
+    if (end != std::string::npos) {
+      std::string rule(content.substr(pos + 1, end - pos - 1));
+      if (!rule.empty()) {
+        std::vector<ttinfo> ttinfos(_ttinfos);
+        _parse_posix(rule.c_str());
+        _ttinfos.swap(ttinfos);
+      }
+    }
+  }
+  return (true);
+}
+
+/**
+ *  Parse a POSIX TZ string ("CET-1CEST,M3.5.0,M10.5.0/3").
+ *
+ *  @param[in] spec  POSIX TZ string.
+ *
+ *  @return true on success.
+ */
+bool timezone_info::_parse_posix(char const* spec) {
+  char const* p(spec);
+
+  // Standard time.
+  ttinfo std_info;
+  long offset(0);
+  if (!parse_abbreviation(p, std_info.abbreviation)
+      || !parse_time(p, offset))
+    return (false);
+  std_info.gmtoff = -offset;
+  std_info.isdst = false;
+
+  // Daylight saving time.
+  ttinfo dst_info;
+  dst_info.gmtoff = 0;
+  dst_info.isdst = true;
+  rule_date dates[2];
+  for (unsigned int i(0); i < 2; ++i) {
+    dates[i].day = 0;
+    dates[i].month = 0;
+    dates[i].time = 0;
+    dates[i].type = 'D';
+    dates[i].week = 0;
+  }
+  if (*p) {
+    if (!parse_abbreviation(p, dst_info.abbreviation))
+      return (false);
+    if ((*p != ',') && *p) {
+      if (!parse_time(p, offset))
+        return (false);
+      dst_info.gmtoff = -offset;
+    }
+    else
+      dst_info.gmtoff = std_info.gmtoff + 60 * 60;
+
+    // Default is the US rule.
+    char const* rule(*p ? p : ",M3.2.0,M11.1.0");
+    for (unsigned int i(0); i < 2; ++i) {
+      if (*rule++ != ',')
+        return (false);
+      rule_date& date(dates[i]);
+      long value(0);
+      date.time = 2 * 60 * 60;
+      if (*rule == 'M') {
+        date.type = 'M';
+        long month(0);
+        long week(0);
+        if (!parse_number(++rule, month)
+            || (*rule++ != '.')
+            || !parse_number(rule, week)
+            || (*rule++ != '.')
+            || !parse_number(rule, value)
+            || (month < 1) || (month > 12)
+            || (week < 1) || (week > 5)
+            || (value > 6))
+          return (false);
+        date.month = month;
+        date.week = week;
+      }
+      else if (*rule == 'J') {
+        date.type = 'J';
+        if (!parse_number(++rule, value) || (value < 1) || (value > 365))
+          return (false);
+      }
+      else {
+        date.type = 'D';
+        if (!parse_number(rule, value) || (value > 365))
+          return (false);
+      }
+      date.day = value;
+      if ((*rule == '/') && !parse_time(++rule, date.time))
+        return (false);
+    }
+    if (*rule)
+      return (false);
+  }
+
+  _has_rule = true;
+  _rule_std = std_info;
+  _rule_dst = dst_info;
+  _dst_start = dates[0];
+  _dst_end = dates[1];
+  _ttinfos.assign(1, std_info);
+  return (true);
+}
+
+/**
+ *  Get the local time type of the POSIX rule at some time.
+ *
+ *  @param[in] t  Time.
+ *
+ *  @return Local time type.
+ */
+timezone_info::ttinfo const& timezone_info::_rule_ttinfo(
+                                              time_t t) const {
+  if (_rule_dst.abbreviation.empty())
+    return (_rule_std);
+  long year;
+  int month;
+  int day;
+  civil_from_days(
+    floor_div(t + _rule_std.gmtoff, 24 * 60 * 60),
+    year,
+    month,
+    day);
+  time_t start(_rule_transition(_dst_start, year, _rule_std.gmtoff));
+  time_t end(_rule_transition(_dst_end, year, _rule_dst.gmtoff));
+  bool isdst((start < end)
+             ? ((t >= start) && (t < end))
+             : !((t >= end) && (t < start)));
+  return (isdst ? _rule_dst : _rule_std);
+}
+
+/**
+ *  Get the time of a POSIX rule transition.
+ *
+ *  @param[in] date    Rule date.
+ *  @param[in] year    Year.
+ *  @param[in] gmtoff  UTC offset in use before the transition.
+ *
+ *  @return Transition time.
+ */
+time_t timezone_info::_rule_transition(
+                        rule_date const& date,
+                        long year,
+                        long gmtoff) {
+  long days;
+  if (date.type == 'J')
+    days = days_from_civil(year, 1, 1)
+           + date.day - 1
+           + ((date.day >= 60) && is_leap_year(year));
+  else if (date.type == 'D')
+    days = days_from_civil(year, 1, 1) + date.day;
+  else {
+    long first(days_from_civil(year, date.month, 1));
+    long next(date.month == 12
+              ? days_from_civil(year + 1, 1, 1)
+              : days_from_civil(year, date.month + 1, 1));
+    int first_wday(static_cast<int>(((first % 7) + 11) % 7));
+    days = first + (date.day - first_wday + 7) % 7 + (date.week - 1) * 7;
+    while (days >= next)
+      days -= 7;
+  }
+  return (static_cast<time_t>(days) * 24 * 60 * 60 + date.time - gmtoff);
+}
@@ -27,13 +27,12 @@ using namespace com::centreon::engine;
  *
  *  @param[in] tz  Timezone to set during object lifetime.
  */
-timezone_locker::timezone_locker(char const* tz) {
-  timezone_manager::instance().push_timezone(tz);
-}
+timezone_locker::timezone_locker(char const* tz)
+  : _previous(timezone_manager::instance().push_timezone(tz)) {}
 
 /**
  *  Destructor.
  */
 timezone_locker::~timezone_locker() {
-  timezone_manager::instance().pop_timezone();
+  timezone_manager::instance().pop_timezone(_previous);
 }
@@ -18,14 +18,49 @@
 */
 
 #include <cstdlib>
-#include <ctime>
+#include "com/centreon/concurrency/locker.hh"
 #include "com/centreon/engine/timezone_manager.hh"
 
+using namespace com::centreon;
 using namespace com::centreon::engine;
 
 // Class instance.
 timezone_manager* timezone_manager::_instance(NULL);
 
+// Current timezone of the thread (NULL is the base timezone).
+static __thread timezone_info const* _current(NULL);
+
+/**
+ *  Get the current timezone of the calling thread.
+ *
+ *  @return Current timezone.
+ */
+timezone_info const& timezone_manager::get_current() const {
+  return (_current ? *_current : _base);
+}
+
+/**
+ *  Get a timezone. It is loaded on first use.
+ *
+ *  @param[in] tz  Timezone, in the format of the TZ environment
+ *                 variable. NULL means the base timezone of the
+ *                 process.
+ *
+ *  @return Timezone.
+ */
+timezone_info const* timezone_manager::get_timezone(char const* tz) {
+  if (!tz)
+    return (&_base);
+  concurrency::locker lock(&_timezones_lock);
+  umap<std::string, timezone_info*>::const_iterator
+    it(_timezones.find(tz));
+  if (it != _timezones.end())
+    return (it->second);
+  timezone_info* info(new timezone_info(tz));
+  _timezones[tz] = info;
+  return (info);
+}
+
 /**
  *  Load singleton.
  */
@@ -37,18 +72,11 @@ void timezone_manager::load() {
 
 /**
  *  Restore timezone previously saved.
+ *
+ *  @param[in] previous  Timezone returned by push_timezone().
  */
-void timezone_manager::pop_timezone() {
-  // No more timezone available equals no change.
-  if (!_tz.empty()) {
-    // Timezone was set.
-    if (_tz.top().is_set)
-      _set_timezone(_tz.top().tz_name.c_str());
-    // Timezone was not set.
-    else
-      _set_timezone(NULL);
-    _tz.pop();
-  }
+void timezone_manager::pop_timezone(timezone_info const* previous) {
+  _current = previous;
   return ;
 }
 
@@ -56,21 +84,31 @@ void timezone_manager::pop_timezone() {
  *  Save current timezone and set new one.
  *
  *  @param[in] tz  New timezone.
+ *
+ *  @return Previous timezone, to give back to pop_timezone().
  */
-void timezone_manager::push_timezone(char const* tz) {
-  // Backup previous timezone.
-  tz_info info;
-  _backup_timezone(&info);
-  _tz.push(info);
-
-  // Set new timezone.
-  if (tz)
-    _set_timezone(tz);
-  else if (_base.is_set)
-    _set_timezone(_base.tz_name.c_str());
-  else
-    _set_timezone(NULL);
+timezone_info const* timezone_manager::push_timezone(char const* tz) {
+  timezone_info const* previous(_current);
+  _current = get_timezone(tz);
+  return (previous);
+}
 
+/**
+ *  Drop loaded timezones, so that changes of the zoneinfo database
+ *  are taken into account. Timezones are loaded again on next use.
+ *  Timezones previously returned must not be used anymore, this is
+ *  called on configuration reload, along with the clearing of the
+ *  timeperiod calendars that refer to them.
+ */
+void timezone_manager::reload() {
+  concurrency::locker lock(&_timezones_lock);
+  for (umap<std::string, timezone_info*>::iterator
+         it(_timezones.begin()), end(_timezones.end());
+       it != end;
+       ++it)
+    delete it->second;
+  _timezones.clear();
+  _base = timezone_info(getenv("TZ"));
   return ;
 }
 
@@ -86,64 +124,16 @@ void timezone_manager::unload() {
 /**
  *  Default constructor.
  */
-timezone_manager::timezone_manager() {
-  _backup_timezone(&_base);
-}
-
-/**
- *  Copy constructor.
- *
- *  @param[in] other  Object to copy.
- */
-timezone_manager::timezone_manager(timezone_manager const& other)
-  : _tz(other._tz) {}
+timezone_manager::timezone_manager()
+  : _base(getenv("TZ")) {}
 
 /**
  *  Destructor.
  */
-timezone_manager::~timezone_manager() {}
-
-/**
- *  Assignment operator.
- *
- *  @param[in] other  Object to copy.
- *
- *  @return This object.
- */
-timezone_manager& timezone_manager::operator=(
-                                      timezone_manager const& other) {
-  if (this != &other)
-    _tz = other._tz;
-  return (*this);
-}
-
-/**
- *  Backup current timezone.
- *
- *  @param[out] info  Timezone information.
- */
-void timezone_manager::_backup_timezone(
-                         timezone_manager::tz_info* info) {
-  char* old_tz(getenv("TZ"));
-  if (old_tz) {
-    info->is_set = true;
-    info->tz_name = old_tz;
-  }
-  else
-    info->is_set = false;
-  return ;
-}
-
-/**
- *  Set new timezone.
- *
- *  @param[in] info  Timezone information.
- */
-void timezone_manager::_set_timezone(char const* tz) {
-  if (tz)
-    setenv("TZ", tz, 1);
-  else
-    unsetenv("TZ");
-  tzset();
-  return ;
+timezone_manager::~timezone_manager() {
+  for (umap<std::string, timezone_info*>::iterator
+         it(_timezones.begin()), end(_timezones.end());
+       it != end;
+       ++it)
+    delete it->second;
 }
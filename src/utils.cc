@@ -44,6 +44,7 @@
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/command_template.hh"
 #include "com/centreon/engine/nebmods.hh"
 #include "com/centreon/engine/notifications.hh"
 #include "com/centreon/engine/objects/comment.hh"
@@ -188,13 +189,6 @@ int get_raw_command_line_r(
       char const* cmd,
       char** full_command,
       int macro_options) {
-  char temp_arg[MAX_COMMAND_BUFFER] = "";
-  char* arg_buffer = NULL;
-  unsigned int x = 0;
-  unsigned int y = 0;
-  int arg_index = 0;
-  int escaped = false;
-
   logger(dbg_functions, basic)
     << "get_raw_command_line_r()";
 
@@ -217,48 +211,17 @@ int get_raw_command_line_r(
 
   /* get the command arguments */
   if (cmd != NULL) {
-    /* skip the command name (we're about to get the arguments)... */
-    for (arg_index = 0;; arg_index++) {
-      if (cmd[arg_index] == '!' || cmd[arg_index] == '\x0')
-        break;
-    }
-
-    /* get each command argument */
-    for (x = 0; x < MAX_COMMAND_ARGUMENTS; x++) {
-      /* we reached the end of the arguments... */
-      if (cmd[arg_index] == '\x0')
-        break;
-
-      /* get the next argument */
-      /* can't use strtok(), as that's used in process_macros... */
-      for (arg_index++, y = 0; y < sizeof(temp_arg) - 1; arg_index++) {
-
-        /* backslashes escape */
-        if (cmd[arg_index] == '\\' && escaped == false) {
-          escaped = true;
-          continue;
-        }
-
-        /* end of argument */
-        if ((cmd[arg_index] == '!'
-             && escaped == false)
-            || cmd[arg_index] == '\x0')
-          break;
-
-        /* normal of escaped char */
-        temp_arg[y] = cmd[arg_index];
-        y++;
-
-        /* clear escaped flag */
-        escaped = false;
-      }
-      temp_arg[y] = '\x0';
-
-      /* ADDED 01/29/04 EG */
-      /* process any macros we find in the argument */
-      process_macros_r(mac, temp_arg, &arg_buffer, macro_options);
-
-      mac->argv[x] = arg_buffer;
+    /* arguments of configured check commands are compiled once */
+    shared_ptr<macros::command_template::argument_list>
+      args(macros::command_template::get_arguments(cmd));
+
+    /* process any macros we find in the arguments, each argument */
+    /* is set once expanded, so that the next ones can use it */
+    std::string arg_buffer;
+    for (unsigned int x(0); x < args->size(); ++x) {
+      arg_buffer.clear();
+      (*args)[x].expand(mac, arg_buffer, macro_options);
+      mac->argv[x] = string::dup(arg_buffer);
     }
   }
 
@@ -1007,19 +970,3 @@ void free_memory(nagios_macros* mac) {
   return;
 }
 
-/* free a notification list that was created */
-void free_notification_list() {
-  notification* temp_notification = NULL;
-  notification* next_notification = NULL;
-
-  temp_notification = notification_list;
-  while (temp_notification != NULL) {
-    next_notification = temp_notification->next;
-    delete temp_notification;
-    temp_notification = next_notification;
-  }
-
-  /* reset notification list pointer */
-  notification_list = NULL;
-  return;
-}
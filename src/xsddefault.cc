@@ -194,6 +194,14 @@ int xsddefault_save_status_data() {
     << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[0] << ","
     << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[1] << ","
     << check_statistics[ACTIVE_CACHED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
+       "\tcoalesced_host_check_stats="
+    << check_statistics[COALESCED_HOST_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[COALESCED_HOST_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[COALESCED_HOST_CHECK_STATS].minute_stats[2] << "\n"
+       "\tcoalesced_service_check_stats="
+    << check_statistics[COALESCED_SERVICE_CHECK_STATS].minute_stats[0] << ","
+    << check_statistics[COALESCED_SERVICE_CHECK_STATS].minute_stats[1] << ","
+    << check_statistics[COALESCED_SERVICE_CHECK_STATS].minute_stats[2] << "\n"
        "\texternal_command_stats="
     << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[0] << ","
     << check_statistics[EXTERNAL_COMMAND_STATS].minute_stats[1] << ","
@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 #include "com/centreon/engine/configuration/parser.hh"
 #include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/setter_index.hh"
 #include "com/centreon/shared_ptr.hh"
 
 using namespace com::centreon;
@@ -201,3 +202,32 @@ TEST(ConfigurationObjectResolveTemplateTest, RecursiveAdditiveInheritance) {
   result.insert("contact5");
   ASSERT_EQ(obj.contacts(), result);
 }
+
+namespace {
+  struct named_setter {
+    char const* name;
+    int         id;
+  };
+}
+
+// Given a setter table with unsorted names and a duplicate name
+// When setters are looked up in its index
+// Then the first setter with the name is found
+// And unknown names are not found
+TEST(ConfigurationSetterIndexTest, FindLikeLinearScan) {
+  static named_setter const table[] = {
+    { "host_name", 0 },
+    { "alias", 1 },
+    { "use", 2 },
+    { "alias", 3 },
+    { "address", 4 }
+  };
+  configuration::setter_index<named_setter> index(table);
+  ASSERT_EQ(index.find("host_name"), table);
+  ASSERT_EQ(index.find("alias"), table + 1);
+  ASSERT_EQ(index.find("use"), table + 2);
+  ASSERT_EQ(index.find("address"), table + 4);
+  ASSERT_TRUE(!index.find("addres"));
+  ASSERT_TRUE(!index.find("zzz"));
+  ASSERT_TRUE(!index.find(""));
+}
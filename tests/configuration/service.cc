@@ -18,6 +18,7 @@
 */
 
 #include <gtest/gtest.h>
+#include "com/centreon/engine/configuration/applier/difference.hh"
 #include "com/centreon/engine/configuration/service.hh"
 #include "com/centreon/engine/error.hh"
 
@@ -62,3 +63,26 @@ TEST(ConfigurationServiceAcknowledgementTimeoutTest, SetToNegativeValue) {
   ASSERT_FALSE(s.set_acknowledgement_timeout(-36));
   ASSERT_EQ(42, s.get_acknowledgement_timeout());
 }
+
+// Given a set of services and a new set where one service changed
+// When their difference is computed
+// Then only the changed service is modified
+TEST(ConfigurationServiceDifferenceTest, OneModified) {
+  configuration::set_service old_services;
+  configuration::set_service new_services;
+  for (unsigned int i(0); i < 10; ++i) {
+    configuration::service s;
+    s.parse("host_name", "h1");
+    s.parse("service_description", std::string(1, 'a' + i).c_str());
+    old_services.insert(s);
+    if (i == 3)
+      s.parse("check_command", "check_ping");
+    new_services.insert(s);
+  }
+  configuration::applier::difference<configuration::set_service>
+    diff(old_services, new_services);
+  ASSERT_TRUE(diff.added().empty());
+  ASSERT_TRUE(diff.deleted().empty());
+  ASSERT_EQ(diff.modified().size(), 1u);
+  ASSERT_EQ(diff.modified().begin()->service_description(), "d");
+}
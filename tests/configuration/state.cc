@@ -0,0 +1,66 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <list>
+#include <string>
+#include "com/centreon/engine/configuration/state.hh"
+
+using namespace com::centreon::engine;
+
+// Given two configurations with different broker modules
+// When their global options are compared
+// Then they are not equal
+TEST(ConfigurationStateGlobalsEqualTest, BrokerModule) {
+  configuration::state s1;
+  configuration::state s2;
+  ASSERT_TRUE(s1.globals_equal(s2));
+  std::list<std::string> modules;
+  modules.push_back("/usr/lib/centreon-engine/externalcmd.so");
+  s2.broker_module(modules);
+  ASSERT_FALSE(s1.globals_equal(s2));
+}
+
+// Given two configurations with different resource files
+// When their global options are compared
+// Then they are not equal
+TEST(ConfigurationStateGlobalsEqualTest, ResourceFile) {
+  configuration::state s1;
+  configuration::state s2;
+  std::list<std::string> files;
+  files.push_back("/etc/centreon-engine/resource.cfg");
+  s2.resource_file(files);
+  ASSERT_FALSE(s1.globals_equal(s2));
+  s1.resource_file(files);
+  ASSERT_TRUE(s1.globals_equal(s2));
+}
+
+// Given two configurations with different services
+// When their global options are compared
+// Then they are equal
+TEST(ConfigurationStateGlobalsEqualTest, IgnoresObjects) {
+  configuration::state s1;
+  configuration::state s2;
+  configuration::service svc;
+  svc.parse("host_name", "h1");
+  svc.parse("service_description", "svc");
+  s2.services().insert(svc);
+  ASSERT_TRUE(s1.globals_equal(s2));
+  ASSERT_FALSE(s1 == s2);
+}
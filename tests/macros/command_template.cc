@@ -0,0 +1,116 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/command_template.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+class MacrosCommandTemplateTest : public ::testing::Test {
+public:
+  void SetUp() {
+    memset(&_mac, 0, sizeof(_mac));
+    _mac.argv[0] = const_cast<char*>("first");
+    _mac.argv[1] = const_cast<char*>("second");
+    macro_user[0] = const_cast<char*>("/usr/lib/plugins");
+  }
+
+  void TearDown() {
+    macro_user[0] = NULL;
+  }
+
+protected:
+  nagios_macros _mac;
+};
+
+// Given a command line without macros
+// When it is expanded
+// Then the output is the command line
+TEST_F(MacrosCommandTemplateTest, Literal) {
+  macros::command_template tmpl("/bin/true -a 1");
+  std::string output;
+  tmpl.expand(&_mac, output);
+  ASSERT_EQ(output, "/bin/true -a 1");
+}
+
+// Given a command line with an escaped $
+// When it is expanded
+// Then $$ is replaced by a single $
+TEST_F(MacrosCommandTemplateTest, EscapedDollar) {
+  macros::command_template tmpl("echo $$HOME $$");
+  std::string output;
+  tmpl.expand(&_mac, output);
+  ASSERT_EQ(output, "echo $HOME $");
+}
+
+// Given a command line with $ARGn$ and $USERn$ macros
+// When it is expanded
+// Then the macros are replaced by their values
+TEST_F(MacrosCommandTemplateTest, ArgvAndUserMacros) {
+  macros::command_template
+    tmpl("$USER1$/check_foo -w $ARG1$ -c $ARG2$ $ARG3$");
+  std::string output;
+  tmpl.expand(&_mac, output);
+  ASSERT_EQ(output, "/usr/lib/plugins/check_foo -w first -c second ");
+}
+
+// Given a command line with an invalid $ARGn$ macro
+// When it is expanded
+// Then the macro is dropped
+TEST_F(MacrosCommandTemplateTest, InvalidArgv) {
+  macros::command_template tmpl("a$ARG0$b$ARG33$c");
+  std::string output;
+  tmpl.expand(&_mac, output);
+  ASSERT_EQ(output, "abc");
+}
+
+// Given a command with escaped '!' in its arguments
+// When get_arguments() is called
+// Then the arguments are split on unescaped '!' only
+TEST_F(MacrosCommandTemplateTest, Arguments) {
+  shared_ptr<macros::command_template::argument_list>
+    args(macros::command_template::get_arguments(
+           "check_foo!a\\!b!$ARG1$!",
+           true));
+  ASSERT_EQ(args->size(), 3u);
+  ASSERT_EQ((*args)[0].get_line(), "a!b");
+  ASSERT_EQ((*args)[1].get_line(), "$ARG1$");
+  ASSERT_EQ((*args)[2].get_line(), "");
+  ASSERT_EQ(
+    args.get(),
+    macros::command_template::get_arguments(
+      "check_foo!a\\!b!$ARG1$!").get());
+  macros::command_template::clear_arguments();
+}
+
+// Given a command whose arguments are not cached
+// When get_arguments() is called twice
+// Then the arguments are compiled again and not kept
+TEST_F(MacrosCommandTemplateTest, UncachedArguments) {
+  shared_ptr<macros::command_template::argument_list>
+    args(macros::command_template::get_arguments("check_bar!x"));
+  ASSERT_EQ(args->size(), 1u);
+  ASSERT_EQ((*args)[0].get_line(), "x");
+  ASSERT_NE(
+    args.get(),
+    macros::command_template::get_arguments("check_bar!x").get());
+}
@@ -0,0 +1,59 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/grab_value.hh"
+
+using namespace com::centreon::engine;
+
+class MacrosFindMacroxTest : public ::testing::Test {
+public:
+  void SetUp() {
+    init_macrox_names();
+  }
+
+  void TearDown() {
+    free_macrox_names();
+  }
+};
+
+// Given the standard macro names
+// When find_macrox() is called with each of them
+// Then the ID of the macro is returned
+TEST_F(MacrosFindMacroxTest, AllStandardMacros) {
+  for (unsigned int x(0); x < MACRO_X_COUNT; ++x) {
+    ASSERT_TRUE(macro_x_names[x] != NULL);
+    ASSERT_EQ(macros::find_macrox(macro_x_names[x]), static_cast<int>(x));
+  }
+}
+
+// Given names that are not standard macros
+// When find_macrox() is called
+// Then -1 is returned
+TEST_F(MacrosFindMacroxTest, UnknownMacros) {
+  ASSERT_EQ(macros::find_macrox(NULL), -1);
+  ASSERT_EQ(macros::find_macrox(""), -1);
+  ASSERT_EQ(macros::find_macrox("ARG1"), -1);
+  ASSERT_EQ(macros::find_macrox("USER1"), -1);
+  ASSERT_EQ(macros::find_macrox("HOSTNAMEX"), -1);
+  ASSERT_EQ(macros::find_macrox("_HOSTFOO"), -1);
+  ASSERT_EQ(macros::find_macrox("ZZZ"), -1);
+}
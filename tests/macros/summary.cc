@@ -0,0 +1,128 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/objects/servicesmember.hh"
+
+using namespace com::centreon::engine;
+
+class MacrosSummaryTest : public ::testing::Test {
+public:
+  void SetUp() {
+    macros::summary::load();
+    memset(&_cntct, 0, sizeof(_cntct));
+    memset(&_contact_member, 0, sizeof(_contact_member));
+    _contact_member.contact_ptr = &_cntct;
+    memset(&_hst, 0, sizeof(_hst));
+    _hst.current_state = HOST_UP;
+    _hst.has_been_checked = true;
+    _hst.checks_enabled = true;
+    memset(&_svc, 0, sizeof(_svc));
+    _svc.current_state = STATE_OK;
+    _svc.has_been_checked = true;
+    _svc.checks_enabled = true;
+    _svc.host_ptr = &_hst;
+    _svc.contacts = &_contact_member;
+    memset(&_service_member, 0, sizeof(_service_member));
+    _service_member.service_ptr = &_svc;
+    _hst.services = &_service_member;
+    macros::summary::instance().update(&_hst);
+    macros::summary::instance().update(&_svc);
+  }
+
+  void TearDown() {
+    macros::summary::unload();
+  }
+
+protected:
+  contact        _cntct;
+  contactsmember _contact_member;
+  host           _hst;
+  servicesmember _service_member;
+  service        _svc;
+};
+
+// Given a host UP with one service OK
+// When totals are retrieved
+// Then the host and the service are counted
+TEST_F(MacrosSummaryTest, Initial) {
+  macros::summary::totals const&
+    t(macros::summary::instance().get_totals());
+  ASSERT_EQ(t.hosts_up, 1u);
+  ASSERT_EQ(t.services_ok, 1u);
+  macros::summary::host_services const&
+    hs(macros::summary::instance().get_host_services(&_hst));
+  ASSERT_EQ(hs.total, 1u);
+  ASSERT_EQ(hs.ok, 1u);
+}
+
+// Given a service OK
+// When it becomes CRITICAL and is then acknowledged
+// Then totals move from unhandled to handled critical
+TEST_F(MacrosSummaryTest, ServiceAcknowledged) {
+  _svc.current_state = STATE_CRITICAL;
+  macros::summary::instance().update(&_svc);
+  macros::summary::totals const&
+    t(macros::summary::instance().get_totals());
+  ASSERT_EQ(t.services_ok, 0u);
+  ASSERT_EQ(t.services_critical, 1u);
+  ASSERT_EQ(t.services_critical_unhandled, 1u);
+  ASSERT_EQ(
+    macros::summary::instance().get_host_services(&_hst).critical,
+    1u);
+
+  _svc.problem_has_been_acknowledged = true;
+  macros::summary::instance().update(&_svc);
+  ASSERT_EQ(t.services_critical, 1u);
+  ASSERT_EQ(t.services_critical_unhandled, 0u);
+}
+
+// Given a service CRITICAL
+// When its host goes DOWN
+// Then the service problem is handled
+TEST_F(MacrosSummaryTest, HostDown) {
+  _svc.current_state = STATE_CRITICAL;
+  macros::summary::instance().update(&_svc);
+  _hst.current_state = HOST_DOWN;
+  macros::summary::instance().update(&_hst);
+  macros::summary::totals const&
+    t(macros::summary::instance().get_totals());
+  ASSERT_EQ(t.hosts_up, 0u);
+  ASSERT_EQ(t.hosts_down, 1u);
+  ASSERT_EQ(t.hosts_down_unhandled, 1u);
+  ASSERT_EQ(t.services_critical, 1u);
+  ASSERT_EQ(t.services_critical_unhandled, 0u);
+}
+
+// Given a service of a contact
+// When totals are retrieved for this contact or another one
+// Then only the services of the contact are counted
+TEST_F(MacrosSummaryTest, ContactTotals) {
+  contact other;
+  memset(&other, 0, sizeof(other));
+  ASSERT_EQ(
+    macros::summary::instance().get_totals(&_cntct).services_ok,
+    1u);
+  ASSERT_EQ(
+    macros::summary::instance().get_totals(&other).services_ok,
+    0u);
+}
@@ -0,0 +1,190 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <ctime>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
+#include "com/centreon/shared_ptr.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+static std::vector<std::string> sent_commands;
+
+static int record_system_command(int callback_type, void* data) {
+  (void)callback_type;
+  nebstruct_system_command_data const*
+    ds(static_cast<nebstruct_system_command_data*>(data));
+  if (ds->type == NEBTYPE_SYSTEM_COMMAND_START)
+    sent_commands.push_back(ds->command_line);
+  return (0);
+}
+
+class NotificationsDigestTest : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    config->enable_environment_macros(false);
+    config->interval_length(1);
+    configuration::applier::state::load();
+    notifications::dispatcher::load();
+    notifications::digest::load();
+    neb_register_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      this,
+      0,
+      &record_system_command);
+    sent_commands.clear();
+
+    memset(&_cmd, 0, sizeof(_cmd));
+    _cmd.name = const_cast<char*>("notify");
+    _cmd.command_line = const_cast<char*>(
+      "/bin/echo $NOTIFICATIONTYPE$ $NOTIFICATIONDIGESTCOUNT$ "
+      "$NOTIFICATIONDIGEST$");
+    memset(&_cmd_member, 0, sizeof(_cmd_member));
+    _cmd_member.cmd = const_cast<char*>("notify");
+    _cmd_member.command_ptr = &_cmd;
+    _cntct = new contact_struct;
+    memset(_cntct, 0, sizeof(*_cntct));
+    _cntct->name = const_cast<char*>("admin");
+    _cntct->host_notification_commands = &_cmd_member;
+    _cntct->service_notification_commands = &_cmd_member;
+    configuration::applier::state::instance().contacts()["admin"]
+      = shared_ptr<contact_struct>(_cntct);
+    contact_other_props["admin"].notification_digest_interval = 10;
+  }
+
+  void TearDown() {
+    contact_other_props.clear();
+    configuration::applier::state::instance().contacts().clear();
+    neb_deregister_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      &record_system_command);
+    notifications::digest::unload();
+    notifications::dispatcher::unload();
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+protected:
+  command        _cmd;
+  commandsmember _cmd_member;
+  contact*       _cntct;
+};
+
+// Given a contact without notification digest interval
+// When a notification is pushed
+// Then it is not coalesced
+TEST_F(NotificationsDigestTest, NoInterval) {
+  contact_other_props["admin"].notification_digest_interval = 0;
+  ASSERT_FALSE(notifications::digest::instance().push(
+                 _cntct,
+                 HOST_NOTIFICATION,
+                 "PROBLEM;h1;DOWN;timeout"));
+}
+
+// Given a contact with a notification digest interval
+// When notifications are pushed
+// Then nothing is sent before the end of the interval
+// And a single command is sent with all notifications after it
+TEST_F(NotificationsDigestTest, Flush) {
+  time_t now(time(NULL));
+  ASSERT_TRUE(notifications::digest::instance().push(
+                _cntct,
+                HOST_NOTIFICATION,
+                "PROBLEM;h1;DOWN;timeout"));
+  ASSERT_TRUE(notifications::digest::instance().push(
+                _cntct,
+                HOST_NOTIFICATION,
+                "PROBLEM;h2;DOWN;refused"));
+  notifications::digest::instance().flush(now);
+  ASSERT_TRUE(sent_commands.empty());
+  notifications::digest::instance().flush(now + 11);
+  ASSERT_EQ(sent_commands.size(), 1u);
+  ASSERT_EQ(
+    sent_commands[0],
+    "/bin/echo DIGEST 2 PROBLEM;h1;DOWN;timeout\\nPROBLEM;h2;DOWN;refused");
+  notifications::digest::instance().flush(now + 22);
+  ASSERT_EQ(sent_commands.size(), 1u);
+}
+
+// Given a contact with pending host and service notifications
+// When all digests are flushed
+// Then one command is sent per notification type
+TEST_F(NotificationsDigestTest, FlushAll) {
+  notifications::digest::instance().push(
+    _cntct,
+    HOST_NOTIFICATION,
+    "PROBLEM;h1;DOWN;timeout");
+  notifications::digest::instance().push(
+    _cntct,
+    SERVICE_NOTIFICATION,
+    "PROBLEM;h1;ping;CRITICAL;loss 100%");
+  notifications::digest::instance().flush_all();
+  ASSERT_EQ(sent_commands.size(), 2u);
+  ASSERT_EQ(
+    sent_commands[0],
+    "/bin/echo DIGEST 1 PROBLEM;h1;DOWN;timeout");
+  ASSERT_EQ(
+    sent_commands[1],
+    "/bin/echo DIGEST 1 PROBLEM;h1;ping;CRITICAL;loss 100%");
+  notifications::digest::instance().flush_all();
+  ASSERT_EQ(sent_commands.size(), 2u);
+}
+
+// Given a notification whose line contains a backslash and a newline
+// When its digest is sent
+// Then they are escaped like long plugin output
+TEST_F(NotificationsDigestTest, EscapedLines) {
+  notifications::digest::instance().push(
+    _cntct,
+    HOST_NOTIFICATION,
+    "PROBLEM;h1;DOWN;C:\\ full\nretrying");
+  notifications::digest::instance().flush_all();
+  ASSERT_EQ(sent_commands.size(), 1u);
+  ASSERT_EQ(
+    sent_commands[0],
+    "/bin/echo DIGEST 1 PROBLEM;h1;DOWN;C:\\\\ full\\nretrying");
+}
+
+// Given a digest whose contact was removed
+// When it is sent
+// Then it is dropped
+TEST_F(NotificationsDigestTest, RemovedContact) {
+  notifications::digest::instance().push(
+    _cntct,
+    HOST_NOTIFICATION,
+    "PROBLEM;h1;DOWN;timeout");
+  configuration::applier::state::instance().contacts().clear();
+  notifications::digest::instance().flush_all();
+  ASSERT_TRUE(sent_commands.empty());
+}
@@ -0,0 +1,135 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/notifications.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
+
+using namespace com::centreon::engine;
+
+static std::vector<int> system_command_events;
+
+static int record_system_command(int callback_type, void* data) {
+  (void)callback_type;
+  system_command_events.push_back(
+    static_cast<nebstruct_system_command_data*>(data)->type);
+  return (0);
+}
+
+class NotificationsDispatcherTest : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    config->enable_environment_macros(false);
+    notifications::dispatcher::load();
+    neb_register_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      this,
+      0,
+      &record_system_command);
+    system_command_events.clear();
+    memset(&_mac, 0, sizeof(_mac));
+  }
+
+  void TearDown() {
+    neb_deregister_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      &record_system_command);
+    notifications::dispatcher::unload();
+    delete config;
+    config = NULL;
+  }
+
+protected:
+  nagios_macros _mac;
+};
+
+// Given a default configuration
+// Then notification commands are run synchronously
+TEST_F(NotificationsDispatcherTest, SynchronousByDefault) {
+  ASSERT_EQ(config->notification_workers(), 0u);
+}
+
+// Given a dispatcher without workers
+// When a notification command is run
+// Then start and end events are sent before run() returns
+TEST_F(NotificationsDispatcherTest, Synchronous) {
+  notifications::dispatcher::instance().configure(0, 1);
+  notifications::dispatcher::instance().run(
+    _mac,
+    "/bin/true",
+    5,
+    "admin",
+    HOST_NOTIFICATION);
+  ASSERT_EQ(system_command_events.size(), 2u);
+  ASSERT_EQ(system_command_events[0], NEBTYPE_SYSTEM_COMMAND_START);
+  ASSERT_EQ(system_command_events[1], NEBTYPE_SYSTEM_COMMAND_END);
+}
+
+// Given a dispatcher with workers
+// When a notification command is run
+// Then the start event is sent when the command is submitted
+// And the end event is sent when the result is reaped
+TEST_F(NotificationsDispatcherTest, StartSentOnSubmit) {
+  notifications::dispatcher::instance().configure(2, 16);
+  notifications::dispatcher::instance().run(
+    _mac,
+    "/bin/true",
+    5,
+    "admin",
+    SERVICE_NOTIFICATION);
+  ASSERT_EQ(system_command_events.size(), 1u);
+  ASSERT_EQ(system_command_events[0], NEBTYPE_SYSTEM_COMMAND_START);
+  notifications::dispatcher::instance().wait();
+  ASSERT_EQ(system_command_events.size(), 2u);
+  ASSERT_EQ(system_command_events[1], NEBTYPE_SYSTEM_COMMAND_END);
+}
+
+// Given a dispatcher with workers and queued commands
+// When it is configured without workers
+// Then queued commands are run and reaped
+// And next commands are run synchronously
+TEST_F(NotificationsDispatcherTest, Reconfigure) {
+  notifications::dispatcher::instance().configure(1, 1);
+  for (unsigned int i(0); i < 3; ++i)
+    notifications::dispatcher::instance().run(
+      _mac,
+      "/bin/true",
+      5,
+      "admin",
+      HOST_NOTIFICATION);
+  notifications::dispatcher::instance().configure(0, 1);
+  ASSERT_EQ(system_command_events.size(), 6u);
+  notifications::dispatcher::instance().run(
+    _mac,
+    "/bin/true",
+    5,
+    "admin",
+    HOST_NOTIFICATION);
+  ASSERT_EQ(system_command_events.size(), 8u);
+  ASSERT_EQ(system_command_events[7], NEBTYPE_SYSTEM_COMMAND_END);
+}
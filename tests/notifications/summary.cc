@@ -0,0 +1,140 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/configuration/applier/state.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros/summary.hh"
+#include "com/centreon/engine/nebcallbacks.hh"
+#include "com/centreon/engine/nebmods.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/notifications/digest.hh"
+#include "com/centreon/engine/notifications/dispatcher.hh"
+#include "com/centreon/engine/sehandlers.hh"
+
+using namespace com::centreon::engine;
+
+static std::vector<std::string> sent_commands;
+
+static int record_system_command(int callback_type, void* data) {
+  (void)callback_type;
+  nebstruct_system_command_data const*
+    ds(static_cast<nebstruct_system_command_data*>(data));
+  if (ds->type == NEBTYPE_SYSTEM_COMMAND_START)
+    sent_commands.push_back(ds->command_line);
+  return (0);
+}
+
+class NotificationsSummaryTest : public ::testing::Test {
+public:
+  void SetUp() {
+    config = new configuration::state;
+    config->enable_environment_macros(false);
+    config->enable_event_handlers(false);
+    config->interval_length(1);
+    configuration::applier::state::load();
+    notifications::dispatcher::load();
+    notifications::digest::load();
+    macros::summary::load();
+    neb_register_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      this,
+      0,
+      &record_system_command);
+    sent_commands.clear();
+
+    memset(&_cmd, 0, sizeof(_cmd));
+    _cmd.name = const_cast<char*>("notify");
+    _cmd.command_line = const_cast<char*>(
+      "/bin/echo $NOTIFICATIONTYPE$ $TOTALHOSTSDOWN$ $TOTALHOSTSUP$");
+    memset(&_cmd_member, 0, sizeof(_cmd_member));
+    _cmd_member.cmd = const_cast<char*>("notify");
+    _cmd_member.command_ptr = &_cmd;
+    memset(&_cntct, 0, sizeof(_cntct));
+    _cntct.name = const_cast<char*>("admin");
+    _cntct.alias = const_cast<char*>("admin");
+    _cntct.host_notification_commands = &_cmd_member;
+    _cntct.host_notifications_enabled = true;
+    _cntct.notify_on_host_down = true;
+    _cntct.notify_on_host_recovery = true;
+    memset(&_contact_member, 0, sizeof(_contact_member));
+    _contact_member.contact_name = const_cast<char*>("admin");
+    _contact_member.contact_ptr = &_cntct;
+
+    memset(&_hst, 0, sizeof(_hst));
+    _hst.name = const_cast<char*>("h1");
+    _hst.display_name = const_cast<char*>("h1");
+    _hst.alias = const_cast<char*>("h1");
+    _hst.address = const_cast<char*>("127.0.0.1");
+    _hst.contacts = &_contact_member;
+    _hst.current_state = HOST_UP;
+    _hst.last_state = HOST_UP;
+    _hst.last_hard_state = HOST_UP;
+    _hst.state_type = HARD_STATE;
+    _hst.has_been_checked = true;
+    _hst.checks_enabled = true;
+    _hst.notifications_enabled = true;
+    _hst.notify_on_down = true;
+    _hst.notify_on_recovery = true;
+    macros::summary::instance().update(&_hst);
+  }
+
+  void TearDown() {
+    contact_other_props.clear();
+    host_other_props.clear();
+    neb_deregister_callback(
+      NEBCALLBACK_SYSTEM_COMMAND_DATA,
+      &record_system_command);
+    macros::summary::unload();
+    notifications::digest::unload();
+    notifications::dispatcher::unload();
+    configuration::applier::state::unload();
+    delete config;
+    config = NULL;
+  }
+
+protected:
+  command        _cmd;
+  commandsmember _cmd_member;
+  contact        _cntct;
+  contactsmember _contact_member;
+  host           _hst;
+};
+
+// Given a host UP counted in the summary macros
+// When it goes DOWN and then recovers
+// Then each notification expands the totals with the new host state
+TEST_F(NotificationsSummaryTest, HostStateChange) {
+  _hst.current_state = HOST_DOWN;
+  handle_host_state(&_hst);
+  ASSERT_EQ(sent_commands.size(), 1u);
+  ASSERT_EQ(sent_commands[0], "/bin/echo PROBLEM 1 0");
+
+  _hst.last_state = HOST_DOWN;
+  _hst.last_hard_state = HOST_DOWN;
+  _hst.current_state = HOST_UP;
+  handle_host_state(&_hst);
+  ASSERT_EQ(sent_commands.size(), 2u);
+  ASSERT_EQ(sent_commands[1], "/bin/echo RECOVERY 0 1");
+}
@@ -0,0 +1,124 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/state_history.hh"
+
+/**
+ *  Historical computation of the percent state change, looping over
+ *  the whole state history.
+ *
+ *  @param[in] history  State history.
+ *  @param[in] index    Index of the oldest entry.
+ *
+ *  @return Percent state change.
+ */
+static double reference_percent_change(
+                int const history[],
+                unsigned int index) {
+  double low_curve_value(0.75);
+  double high_curve_value(1.25);
+  double curved_changes(0.0);
+  int last_state_history_value(history[index]);
+  for (unsigned int x(1); x < MAX_STATE_HISTORY_ENTRIES; ++x) {
+    int value(history[(index + x) % MAX_STATE_HISTORY_ENTRIES]);
+    if (last_state_history_value != value)
+      curved_changes
+        += (((double)(x - 1) * (high_curve_value - low_curve_value))
+            / ((double)(MAX_STATE_HISTORY_ENTRIES - 2))) + low_curve_value;
+    last_state_history_value = value;
+  }
+  return ((double)(((double)curved_changes * 100.0)
+                   / (double)(MAX_STATE_HISTORY_ENTRIES - 1)));
+}
+
+/**
+ *  Flapping decision.
+ *
+ *  @param[in] percent_change  Percent state change.
+ *  @param[in] low             Low threshold.
+ *  @param[in] high            High threshold.
+ *
+ *  @return 0 if not flapping, 1 if flapping, 2 if undecided.
+ */
+static int decision(double percent_change, double low, double high) {
+  if ((percent_change > low) && (percent_change < high))
+    return (2);
+  return ((percent_change <= low) ? 0 : 1);
+}
+
+// Given random sequences of states
+// When they are pushed in a state history
+// Then flapping decisions are the ones of the historical algorithm
+TEST(StateHistory, SameDecisionsAsReference) {
+  static double const thresholds[][2] = {
+    { 20.0, 30.0 },
+    { 5.0, 20.0 },
+    { 25.0, 50.0 },
+    { 15.0, 25.0 },
+    { 10.0, 40.0 }
+  };
+  srand(42);
+  for (unsigned int sequence(0); sequence < 200; ++sequence) {
+    int history[MAX_STATE_HISTORY_ENTRIES];
+    memset(history, 0, sizeof(history));
+    unsigned int index(0);
+    state_history_changes changes;
+    memset(&changes, 0, sizeof(changes));
+    int states(2 + sequence % 3);
+    for (unsigned int i(0); i < 500; ++i) {
+      push_state_history(history, &index, &changes, rand() % states);
+      double expected(reference_percent_change(history, index));
+      for (unsigned int t(0);
+           t < sizeof(thresholds) / sizeof(*thresholds);
+           ++t) {
+        double low(thresholds[t][0]);
+        double high(thresholds[t][1]);
+        double computed(
+                 get_state_history_percent_change(&changes, low, high));
+        ASSERT_NEAR(computed, expected, 1e-9);
+        ASSERT_EQ(
+          decision(computed, low, high),
+          decision(expected, low, high));
+      }
+    }
+  }
+}
+
+// Given a state history filled with random states
+// When its changes are rebuilt
+// Then they are the ones maintained by push_state_history()
+TEST(StateHistory, RebuildLikePush) {
+  srand(4242);
+  int history[MAX_STATE_HISTORY_ENTRIES];
+  memset(history, 0, sizeof(history));
+  unsigned int index(0);
+  state_history_changes changes;
+  memset(&changes, 0, sizeof(changes));
+  for (unsigned int i(0); i < 1000; ++i) {
+    push_state_history(history, &index, &changes, rand() % 3);
+    state_history_changes rebuilt;
+    rebuild_state_history_changes(history, index, &rebuilt);
+    ASSERT_EQ(rebuilt.count, changes.count);
+    ASSERT_EQ(rebuilt.mask, changes.mask);
+    ASSERT_EQ(rebuilt.positions, changes.positions);
+  }
+}
@@ -0,0 +1,49 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/string.hh"
+
+using namespace com::centreon::engine;
+
+// Given a string interned twice
+// When it is compared and released once
+// Then both references share the same buffer, which stays valid
+TEST(StringIntern, SharedCopy) {
+  char name[] = "host-01.example.com";
+  char* first(string::intern(name));
+  char* second(string::intern("host-01.example.com"));
+  ASSERT_NE(first, name);
+  ASSERT_EQ(first, second);
+  ASSERT_STREQ(first, "host-01.example.com");
+  string::unintern(first);
+  ASSERT_STREQ(second, "host-01.example.com");
+  ASSERT_EQ(string::intern(name), second);
+  string::unintern(second);
+  string::unintern(second);
+}
+
+// Given a NULL string
+// When it is interned and released
+// Then nothing is stored
+TEST(StringIntern, Null) {
+  ASSERT_TRUE(string::intern(NULL) == NULL);
+  string::unintern(NULL);
+}
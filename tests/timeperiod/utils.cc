@@ -21,8 +21,10 @@
 #include <ctime>
 #include "com/centreon/engine/deleter/timeperiod.hh"
 #include "com/centreon/engine/error.hh"
+#include "com/centreon/engine/objects/timeperiod.hh"
 #include "com/centreon/engine/objects/timeperiodexclusion.hh"
 #include "com/centreon/engine/objects/timerange.hh"
+#include "com/centreon/engine/timeperiod.hh"
 #include "tests/timeperiod/utils.hh"
 
 // Global time.
@@ -42,6 +44,7 @@ timeperiod_creator::~timeperiod_creator() {
     _timeperiods = _timeperiods->next;
     com::centreon::engine::deleter::timeperiod(to_delete);
   }
+  clear_timeperiod_calendars();
 }
 
 /**
@@ -0,0 +1,140 @@
+/*
+** Copyright 2019 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <ctime>
+#include <gtest/gtest.h>
+#include "com/centreon/engine/timezone_info.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Build a broken-down time.
+ *
+ *  @param[in] year    Year.
+ *  @param[in] month   Month (1-12).
+ *  @param[in] day     Day of month.
+ *  @param[in] hour    Hour.
+ *  @param[in] minute  Minute.
+ *
+ *  @return Broken-down time with an unknown DST flag.
+ */
+static struct tm make_tm(
+                   int year,
+                   int month,
+                   int day,
+                   int hour,
+                   int minute) {
+  struct tm t;
+  memset(&t, 0, sizeof(t));
+  t.tm_year = year - 1900;
+  t.tm_mon = month - 1;
+  t.tm_mday = day;
+  t.tm_hour = hour;
+  t.tm_min = minute;
+  t.tm_isdst = -1;
+  return (t);
+}
+
+// Given the Europe/Paris timezone
+// When times around the year are broken down
+// Then results are the ones of localtime_r() in this timezone
+TEST(TimezoneInfo, LocaltimeLikeLibc) {
+  timezone_info tz(":Europe/Paris");
+  for (time_t t(1451606400); t < 1483228800; t += 3 * 3600 + 17) {
+    struct tm expected;
+    localtime_r(&t, &expected);
+    struct tm computed;
+    tz.localtime(t, &computed);
+    ASSERT_EQ(computed.tm_year, expected.tm_year);
+    ASSERT_EQ(computed.tm_yday, expected.tm_yday);
+    ASSERT_EQ(computed.tm_wday, expected.tm_wday);
+    ASSERT_EQ(computed.tm_hour, expected.tm_hour);
+    ASSERT_EQ(computed.tm_min, expected.tm_min);
+    ASSERT_EQ(computed.tm_isdst, expected.tm_isdst);
+  }
+}
+
+// Given the Europe/Paris timezone
+// When out of range fields are converted
+// Then they are normalized
+TEST(TimezoneInfo, MktimeNormalizes) {
+  timezone_info tz(":Europe/Paris");
+  struct tm t(make_tm(2016, 12, 31, 24, 0));
+  ASSERT_EQ(tz.mktime(&t), 1483225200);
+  ASSERT_EQ(t.tm_year, 117);
+  ASSERT_EQ(t.tm_mon, 0);
+  ASSERT_EQ(t.tm_mday, 1);
+  ASSERT_EQ(t.tm_hour, 0);
+}
+
+// Given the Europe/Paris timezone
+// When times of DST shifts are converted
+// Then overlapped times are the first ones and missing times are
+// shifted
+TEST(TimezoneInfo, MktimeDSTShifts) {
+  timezone_info tz(":Europe/Paris");
+  struct tm overlapped(make_tm(2016, 10, 30, 2, 30));
+  ASSERT_EQ(tz.mktime(&overlapped), 1477787400);
+  ASSERT_EQ(overlapped.tm_isdst, 1);
+  struct tm missing(make_tm(2016, 3, 27, 2, 30));
+  ASSERT_EQ(tz.mktime(&missing), 1459042200);
+  ASSERT_EQ(missing.tm_hour, 3);
+}
+
+// Given a POSIX TZ string
+// When times are broken down
+// Then the rule of the string is applied
+TEST(TimezoneInfo, PosixString) {
+  timezone_info tz("CET-1CEST,M3.5.0,M10.5.0/3");
+  struct tm t;
+  tz.localtime(1469000000, &t);
+  ASSERT_EQ(t.tm_hour, 9);
+  ASSERT_EQ(t.tm_isdst, 1);
+  tz.localtime(1451606400, &t);
+  ASSERT_EQ(t.tm_hour, 1);
+  ASSERT_EQ(t.tm_isdst, 0);
+}
+
+#ifdef HAVE_TM_ZONE
+// Given a POSIX TZ string
+// When times are broken down
+// Then the offset and the abbreviation of the zone are set
+TEST(TimezoneInfo, ZoneFields) {
+  timezone_info tz("CET-1CEST,M3.5.0,M10.5.0/3");
+  struct tm t;
+  tz.localtime(1469000000, &t);
+  ASSERT_EQ(t.tm_gmtoff, 7200);
+  ASSERT_STREQ(t.tm_zone, "CEST");
+  tz.localtime(1451606400, &t);
+  ASSERT_EQ(t.tm_gmtoff, 3600);
+  ASSERT_STREQ(t.tm_zone, "CET");
+}
+#endif // HAVE_TM_ZONE
+
+// Given an unknown timezone
+// When times are broken down
+// Then UTC is used
+TEST(TimezoneInfo, UnknownIsUTC) {
+  timezone_info tz(":Nowhere/Unknown");
+  struct tm t;
+  tz.localtime(1469000000, &t);
+  ASSERT_EQ(t.tm_hour, 7);
+  ASSERT_EQ(t.tm_min, 33);
+}